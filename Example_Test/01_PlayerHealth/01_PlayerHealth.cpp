@@ -1,6 +1,9 @@
 ﻿#include <iostream>
 #include <windows.h>
 #include <process.h>
+#include <vector>
+#include <memory>
+#include <cstring>
 using namespace std;
 
 struct PlayerData
@@ -31,8 +34,289 @@ unsigned __stdcall HealthRecoveryThread(void* param)
 	return 0;
 }
 
-int main()
+// =============================================================================
+// 체력 컴포넌트 시스템: 동시 피해/회복 이벤트 + 일괄 자연 회복
+// =============================================================================
+// HealthRecoveryThread는 회복 중인 플레이어마다 스레드를 하나 쓰고,
+// player->health를 동기화 없이 읽고 씁니다.
+// HealthComponentSystem은 모든 플레이어의 체력을 배열로 들고,
+// - 피해/회복 이벤트는 CAS 루프로 0~최대 체력 사이로 잘라서 바로 반영하거나
+//   (ApplyDelta), 스레드별 버퍼에 모았다가 틱마다 합쳐서 반영하고 (MergeDeltas),
+// - 자연 회복은 틱마다 한 번 모든 플레이어를 훑는 일괄 패스로 처리합니다.
+
+// 스레드 하나가 쓰는 변화량 버퍼. 플레이어별 합계 배열에 바로 더하므로 이벤트가
+// 아무리 많아도 틱 병합 비용은 "이번 틱에 맞은 플레이어 수"를 넘지 않음
+// 잠금은 틱 병합 때 버퍼를 바꿔 끼울 때만 경쟁함
+class HealthDeltaBuffer
+{
+private:
+	SRWLOCK lock;
+	std::vector<LONG> sums;          // 쓰는 쪽
+	std::vector<UINT32> touched;
+	std::vector<LONG> drainSums;     // 병합 중인 쪽
+	std::vector<UINT32> drainTouched;
+
+public:
+	explicit HealthDeltaBuffer(size_t playerCount) : sums(playerCount, 0), drainSums(playerCount, 0)
+	{
+		InitializeSRWLock(&lock);
+	}
+
+	void Add(UINT32 player, LONG delta)
+	{
+		AcquireSRWLockExclusive(&lock);
+		if (sums[player] == 0) touched.push_back(player);
+		sums[player] += delta;
+		ReleaseSRWLockExclusive(&lock);
+	}
+
+	// 버퍼를 바꿔 끼운 뒤 잠금 밖에서 (플레이어, 합계)를 넘기고 비움
+	template <typename Apply>
+	void Drain(Apply apply)
+	{
+		AcquireSRWLockExclusive(&lock);
+		sums.swap(drainSums);
+		touched.swap(drainTouched);
+		ReleaseSRWLockExclusive(&lock);
+
+		for (UINT32 player : drainTouched) {
+			if (drainSums[player] != 0) apply(player, drainSums[player]);
+			drainSums[player] = 0;
+		}
+		drainTouched.clear();
+	}
+};
+
+class HealthComponentSystem
+{
+private:
+	size_t count;
+	std::unique_ptr<volatile LONG[]> health;   // Interlocked 함수로만 변경
+	std::unique_ptr<LONG[]> maxHealth;
+	std::unique_ptr<float[]> regenPerSecond;
+	std::unique_ptr<float[]> regenCarry;       // 1 미만으로 남은 회복량 (회복 패스만 사용)
+
+	// 병합용 작업 공간 (틱 스레드만 사용)
+	std::vector<LONG> pendingSum;
+	std::vector<UINT32> touched;
+
+public:
+	HealthComponentSystem(size_t playerCount, LONG max, float regen)
+		: count(playerCount), health(new volatile LONG[playerCount]), maxHealth(new LONG[playerCount]),
+		regenPerSecond(new float[playerCount]), regenCarry(new float[playerCount]), pendingSum(playerCount, 0)
+	{
+		for (size_t i = 0; i < count; ++i) {
+			maxHealth[i] = max;
+			health[i] = max * 3 / 10;
+			regenPerSecond[i] = regen;
+			regenCarry[i] = 0.0f;
+		}
+	}
+
+	// 값을 읽고, 잘라낸 새 값으로 CAS. 다른 스레드가 먼저 바꿨으면 다시 시도
+	LONG ApplyDelta(size_t player, LONG delta)
+	{
+		volatile LONG* target = &health[player];
+		const LONG max = maxHealth[player];
+		LONG current = *target;
+		for (;;) {
+			LONG next = current + delta;
+			if (next < 0) next = 0;
+			if (next > max) next = max;
+			if (next == current) return current;
+			LONG observed = InterlockedCompareExchange(target, next, current);
+			if (observed == current) return next;
+			current = observed;
+		}
+	}
+
+	// 스레드별 버퍼를 플레이어별로 합산한 뒤 한 번씩만 반영
+	// (틱 안의 이벤트 순서는 보지 않고 합계를 잘라냄)
+	void MergeDeltas(std::vector<std::unique_ptr<HealthDeltaBuffer>>& buffers)
+	{
+		for (auto& buffer : buffers) {
+			buffer->Drain([this](UINT32 player, LONG sum) {
+				if (pendingSum[player] == 0) touched.push_back(player);
+				pendingSum[player] += sum;
+			});
+		}
+		for (UINT32 player : touched) {
+			if (pendingSum[player] != 0) ApplyDelta(player, pendingSum[player]);
+			pendingSum[player] = 0;
+		}
+		touched.clear();
+	}
+
+	// 자연 회복: 모든 플레이어를 한 번에 훑고, 1 이상 쌓인 만큼만 반영
+	void Regenerate(float dt)
+	{
+		for (size_t i = 0; i < count; ++i) {
+			if (health[i] >= maxHealth[i] || health[i] == 0) continue;   // 가득 찼거나 쓰러진 플레이어는 회복 없음
+			regenCarry[i] += regenPerSecond[i] * dt;
+			if (regenCarry[i] >= 1.0f) {
+				LONG whole = (LONG)regenCarry[i];
+				regenCarry[i] -= (float)whole;
+				ApplyDelta(i, whole);
+			}
+		}
+	}
+
+	// 잠금 비교용: 잠금 안에서 일반 쓰기로 반영
+	void ApplyDeltaUnsafe(size_t player, LONG delta)
+	{
+		LONG next = health[player] + delta;
+		if (next < 0) next = 0;
+		if (next > maxHealth[player]) next = maxHealth[player];
+		health[player] = next;
+	}
+
+	size_t Size() const { return count; }
+	LONG GetHealth(size_t player) const { return health[player]; }
+
+	// 모든 체력이 0~최대 범위 안인지
+	bool Validate() const
+	{
+		for (size_t i = 0; i < count; ++i) {
+			if (health[i] < 0 || health[i] > maxHealth[i]) return false;
+		}
+		return true;
+	}
+};
+
+// ----------------------------------------------------------------------------
+// 10만 명에게 여러 스레드가 동시에 피해/회복을 넣는 벤치마크
+// ----------------------------------------------------------------------------
+enum HealthUpdateMode
+{
+	kHealthLocked,     // 전역 CRITICAL_SECTION
+	kHealthCas,        // 이벤트마다 CAS
+	kHealthBuffered    // 스레드별 버퍼 + 틱 병합
+};
+
+struct HealthEventParam
 {
+	HealthComponentSystem* system;
+	HealthUpdateMode mode;
+	CRITICAL_SECTION* lock;
+	HealthDeltaBuffer* buffer;
+	volatile bool* stop;
+	UINT32 seed;
+	LONGLONG events;
+};
+
+unsigned __stdcall HealthEventThread(void* param)
+{
+	HealthEventParam* p = (HealthEventParam*)param;
+	UINT32 state = p->seed;
+	LONGLONG events = 0;
+	const UINT32 players = (UINT32)p->system->Size();
+
+	while (!*p->stop) {
+		for (int i = 0; i < 256; ++i) {
+			state = state * 1664525u + 1013904223u;
+			UINT32 player = (state >> 8) % players;
+			LONG delta = (LONG)(state % 36) - 20;   // -20(피해) ~ +15(회복)
+
+			switch (p->mode) {
+			case kHealthLocked:
+				EnterCriticalSection(p->lock);
+				p->system->ApplyDeltaUnsafe(player, delta);
+				LeaveCriticalSection(p->lock);
+				break;
+			case kHealthCas:
+				p->system->ApplyDelta(player, delta);
+				break;
+			case kHealthBuffered:
+				p->buffer->Add(player, delta);
+				break;
+			}
+		}
+		events += 256;
+	}
+	p->events = events;
+	return 0;
+}
+
+void RunHealthBench(const char* label, HealthUpdateMode mode, size_t playerCount, int threadCount, double seconds)
+{
+	HealthComponentSystem system(playerCount, 100, 10.0f);
+	CRITICAL_SECTION lock;
+	InitializeCriticalSection(&lock);
+	volatile bool stop = false;
+
+	std::vector<std::unique_ptr<HealthDeltaBuffer>> buffers;
+	std::vector<HealthEventParam> params(threadCount);
+	std::vector<HANDLE> threads;
+	for (int i = 0; i < threadCount; ++i) {
+		buffers.emplace_back(new HealthDeltaBuffer(playerCount));
+		params[i] = { &system, mode, &lock, buffers.back().get(), &stop, 1234u + i * 7919u, 0 };
+		HANDLE hThread = (HANDLE)_beginthreadex(nullptr, 0, HealthEventThread, &params[i], 0, nullptr);
+		if (hThread) threads.push_back(hThread);
+	}
+
+	// 메인 스레드가 60Hz 틱: (병합) + 자연 회복
+	LARGE_INTEGER frequency, start, now, tickStart, tickEnd;
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&start);
+	const float dt = 1.0f / 60.0f;
+	int ticks = 0;
+	double tickTotalMs = 0.0, tickMaxMs = 0.0;
+	do {
+		QueryPerformanceCounter(&tickStart);
+		if (mode == kHealthLocked) {
+			EnterCriticalSection(&lock);
+			system.Regenerate(dt);
+			LeaveCriticalSection(&lock);
+		}
+		else {
+			if (mode == kHealthBuffered) system.MergeDeltas(buffers);
+			system.Regenerate(dt);
+		}
+		QueryPerformanceCounter(&tickEnd);
+		double tickMs = (double)(tickEnd.QuadPart - tickStart.QuadPart) * 1000.0 / frequency.QuadPart;
+		tickTotalMs += tickMs;
+		if (tickMs > tickMaxMs) tickMaxMs = tickMs;
+		++ticks;
+
+		if (tickMs < 16.0) Sleep((DWORD)(16.0 - tickMs));
+		QueryPerformanceCounter(&now);
+	} while ((double)(now.QuadPart - start.QuadPart) / frequency.QuadPart < seconds);
+
+	stop = true;
+	WaitForMultipleObjects((DWORD)threads.size(), threads.data(), TRUE, INFINITE);
+	for (HANDLE h : threads) CloseHandle(h);
+	if (mode == kHealthBuffered) system.MergeDeltas(buffers);   // 마지막 틱 이후 이벤트
+	QueryPerformanceCounter(&now);
+	double elapsed = (double)(now.QuadPart - start.QuadPart) / frequency.QuadPart;
+	DeleteCriticalSection(&lock);
+
+	LONGLONG events = 0;
+	for (const auto& p : params) events += p.events;
+	cout << label << " : " << (LONGLONG)(events / elapsed) << " 이벤트/초, 틱 평균 "
+		<< tickTotalMs / ticks << "ms (최대 " << tickMaxMs << "ms), 범위 검사 "
+		<< (system.Validate() ? "통과" : "실패") << endl;
+}
+
+void BenchmarkHealthComponents()
+{
+	const size_t playerCount = 100000;
+	const int threadCount = 8;
+	const double seconds = 2.0;
+
+	cout << "=== 체력 컴포넌트: 플레이어 " << playerCount << "명, 이벤트 스레드 " << threadCount
+		<< "개, 60Hz 자연 회복 ===" << endl;
+	RunHealthBench("전역 잠금          ", kHealthLocked, playerCount, threadCount, seconds);
+	RunHealthBench("CAS (이벤트마다)   ", kHealthCas, playerCount, threadCount, seconds);
+	RunHealthBench("스레드별 버퍼 병합 ", kHealthBuffered, playerCount, threadCount, seconds);
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc > 1 && strcmp(argv[1], "--bench-health") == 0) {
+		BenchmarkHealthComponents();
+		return 0;
+	}
+
 	PlayerData player = { 30, 100, false }; // 초기 체력 50, 최대 체력 100
 	HANDLE hThread = (HANDLE)_beginthreadex(
 		nullptr,
@@ -2,6 +2,10 @@
 #include <windows.h>
 #include <process.h>
 #include <string>
+#include <vector>
+#include <functional>
+#include <cstring>
+#include <algorithm>
 
 struct NPCData {
 	std::string name;
@@ -25,7 +29,659 @@ unsigned __stdcall NPCWorkThread(void* param)
 	return 0;
 }
 
-int main() {
+// =============================================================================
+// 데이터 지향 NPC 시뮬레이션: SoA 배열 + 고정 워커 풀의 parallel-for
+// =============================================================================
+// NPC마다 스레드를 만들면 스택과 커널 객체 때문에 수천 개가 한계이고, 매 틱마다
+// 그만큼의 스레드를 깨워야 합니다.
+// 아래 NpcWorld는 NPC 상태를 필드별 배열(SoA)로 저장하고, 한 틱에 모든 NPC를
+// 한 번씩 갱신합니다. 갱신은 ParallelForPool이 배열을 캐시 크기 청크로 나눠
+// 고정된 워커 스레드들에 나눠 줍니다.
+
+enum NpcJob : unsigned char {
+	kJobIdle,
+	kJobShop,      // 상점 운영
+	kJobGuard,     // 마을 경비
+	kJobSmith,     // 무기 제작
+	kJobCount
+};
+
+// 직업별 작업량(초)과 다음 직업
+const float kJobDuration[kJobCount] = { 2.0f, 3.0f, 5.0f, 4.0f };
+const NpcJob kNextJob[kJobCount] = { kJobShop, kJobGuard, kJobSmith, kJobIdle };
+
+class NpcWorld {
+private:
+	std::vector<UINT32> ids;
+	std::vector<unsigned char> jobs;
+	std::vector<float> remainingWork;   // 현재 작업의 남은 시간
+	std::vector<float> timers;          // 현재 작업을 시작한 뒤 지난 시간
+	std::vector<UINT32> completedJobs;
+
+public:
+	void Reserve(size_t count)
+	{
+		ids.reserve(count);
+		jobs.reserve(count);
+		remainingWork.reserve(count);
+		timers.reserve(count);
+		completedJobs.reserve(count);
+	}
+
+	UINT32 Add(NpcJob job, float startOffset)
+	{
+		UINT32 id = (UINT32)ids.size();
+		ids.push_back(id);
+		jobs.push_back(job);
+		remainingWork.push_back(kJobDuration[job] - startOffset);
+		timers.push_back(startOffset);
+		completedJobs.push_back(0);
+		return id;
+	}
+
+	// [begin, end) 범위의 NPC를 dt초만큼 진행 (청크끼리 겹치지 않으므로 잠금 불필요)
+	void TickRange(size_t begin, size_t end, float dt)
+	{
+		unsigned char* job = jobs.data();
+		float* remaining = remainingWork.data();
+		float* timer = timers.data();
+		UINT32* completed = completedJobs.data();
+
+		for (size_t i = begin; i < end; ++i) {
+			remaining[i] -= dt;
+			timer[i] += dt;
+			if (remaining[i] <= 0.0f) {
+				NpcJob next = kNextJob[job[i]];
+				job[i] = next;
+				remaining[i] += kJobDuration[next];
+				timer[i] = 0.0f;
+				++completed[i];
+			}
+		}
+	}
+
+	size_t Size() const { return ids.size(); }
+
+	UINT64 TotalCompletedJobs() const
+	{
+		UINT64 total = 0;
+		for (UINT32 count : completedJobs) total += count;
+		return total;
+	}
+};
+
+// 워커 스레드를 미리 만들어 두고 ParallelFor마다 깨워서 청크를 나눠 가져가게 함
+// 호출한 스레드도 청크를 처리하고, 모든 워커가 끝나야 반환
+class ParallelForPool {
+private:
+	std::vector<HANDLE> threads;
+	CRITICAL_SECTION cs;
+	CONDITION_VARIABLE workReady;
+	CONDITION_VARIABLE workDone;
+	LONG generation;
+	LONG activeWorkers;
+	bool stopping;
+
+	// 현재 작업
+	const std::function<void(size_t, size_t)>* body;
+	size_t itemCount;
+	size_t chunkSize;
+	LONG chunkCount;
+	volatile LONG nextChunk;
+
+	void RunChunks()
+	{
+		for (;;) {
+			LONG chunk = InterlockedIncrement(&nextChunk) - 1;
+			if (chunk >= chunkCount) break;
+			size_t begin = (size_t)chunk * chunkSize;
+			size_t end = begin + chunkSize < itemCount ? begin + chunkSize : itemCount;
+			(*body)(begin, end);
+		}
+	}
+
+	static unsigned __stdcall WorkerThread(void* param)
+	{
+		ParallelForPool* pool = static_cast<ParallelForPool*>(param);
+		LONG seen = 0;
+		for (;;) {
+			EnterCriticalSection(&pool->cs);
+			while (pool->generation == seen && !pool->stopping) {
+				SleepConditionVariableCS(&pool->workReady, &pool->cs, INFINITE);
+			}
+			if (pool->stopping) {
+				LeaveCriticalSection(&pool->cs);
+				break;
+			}
+			seen = pool->generation;
+			LeaveCriticalSection(&pool->cs);
+
+			pool->RunChunks();
+
+			EnterCriticalSection(&pool->cs);
+			if (--pool->activeWorkers == 0) WakeConditionVariable(&pool->workDone);
+			LeaveCriticalSection(&pool->cs);
+		}
+		return 0;
+	}
+
+public:
+	explicit ParallelForPool(int workerCount)
+		: generation(0), activeWorkers(0), stopping(false), body(nullptr), itemCount(0), chunkSize(1), chunkCount(0), nextChunk(0)
+	{
+		InitializeCriticalSection(&cs);
+		InitializeConditionVariable(&workReady);
+		InitializeConditionVariable(&workDone);
+		for (int i = 0; i < workerCount; ++i) {
+			HANDLE hThread = (HANDLE)_beginthreadex(nullptr, 0, WorkerThread, this, 0, nullptr);
+			if (hThread) threads.push_back(hThread);
+		}
+	}
+
+	~ParallelForPool()
+	{
+		EnterCriticalSection(&cs);
+		stopping = true;
+		LeaveCriticalSection(&cs);
+		WakeAllConditionVariable(&workReady);
+		for (HANDLE h : threads) {
+			WaitForSingleObject(h, INFINITE);
+			CloseHandle(h);
+		}
+		DeleteCriticalSection(&cs);
+	}
+
+	void ParallelFor(size_t count, size_t chunk, const std::function<void(size_t, size_t)>& fn)
+	{
+		if (count == 0) return;
+		EnterCriticalSection(&cs);
+		body = &fn;
+		itemCount = count;
+		chunkSize = chunk < 1 ? 1 : chunk;
+		chunkCount = (LONG)((count + chunkSize - 1) / chunkSize);
+		nextChunk = 0;
+		activeWorkers = (LONG)threads.size();
+		++generation;
+		LeaveCriticalSection(&cs);
+		WakeAllConditionVariable(&workReady);
+
+		RunChunks();
+
+		EnterCriticalSection(&cs);
+		while (activeWorkers > 0) SleepConditionVariableCS(&workDone, &cs, INFINITE);
+		LeaveCriticalSection(&cs);
+	}
+
+	int GetWorkerCount() const { return (int)threads.size(); }
+};
+
+// ----------------------------------------------------------------------------
+// 비교용: NPC마다 스레드 하나, 틱마다 모든 스레드를 이벤트로 깨움
+// ----------------------------------------------------------------------------
+struct ThreadedNpc {
+	NpcJob job;
+	float remainingWork;
+	float timer;
+	UINT32 completedJobs;
+	HANDLE hTick;                  // 틱 시작 신호 (자동 리셋)
+	volatile LONG* remainingNpcs;  // 이번 틱에 아직 갱신하지 않은 NPC 수
+	HANDLE hTickDone;
+	volatile bool* stop;
+	float dt;
+};
+
+unsigned __stdcall ThreadedNpcThread(void* param)
+{
+	ThreadedNpc* npc = static_cast<ThreadedNpc*>(param);
+	for (;;) {
+		WaitForSingleObject(npc->hTick, INFINITE);
+		if (*npc->stop) break;
+
+		npc->remainingWork -= npc->dt;
+		npc->timer += npc->dt;
+		if (npc->remainingWork <= 0.0f) {
+			npc->job = kNextJob[npc->job];
+			npc->remainingWork += kJobDuration[npc->job];
+			npc->timer = 0.0f;
+			++npc->completedJobs;
+		}
+		if (InterlockedDecrement(npc->remainingNpcs) == 0) SetEvent(npc->hTickDone);
+	}
+	return 0;
+}
+
+// 측정 시간 동안 몇 틱을 돌렸는지 반환. 스레드를 다 만들지 못하면 -1
+double MeasureThreadPerNpc(size_t npcCount, double seconds)
+{
+	const float dt = 1.0f / 60.0f;
+	volatile LONG remainingNpcs = 0;
+	volatile bool stop = false;
+	HANDLE hTickDone = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+
+	std::vector<ThreadedNpc> npcs(npcCount);
+	std::vector<HANDLE> threads;
+	bool created = true;
+	for (size_t i = 0; i < npcCount; ++i) {
+		ThreadedNpc& npc = npcs[i];
+		npc.job = (NpcJob)(i % kJobCount);
+		npc.remainingWork = kJobDuration[npc.job];
+		npc.timer = 0.0f;
+		npc.completedJobs = 0;
+		npc.hTick = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+		npc.remainingNpcs = &remainingNpcs;
+		npc.hTickDone = hTickDone;
+		npc.stop = &stop;
+		npc.dt = dt;
+
+		// 스레드가 많으므로 스택은 64KB만 예약
+		HANDLE hThread = (HANDLE)_beginthreadex(nullptr, 64 * 1024, ThreadedNpcThread, &npc,
+			STACK_SIZE_PARAM_IS_A_RESERVATION, nullptr);
+		if (hThread == NULL) {
+			created = false;
+			break;
+		}
+		threads.push_back(hThread);
+	}
+
+	double ticksPerSecond = -1.0;
+	if (created) {
+		LARGE_INTEGER frequency, start, now;
+		QueryPerformanceFrequency(&frequency);
+		QueryPerformanceCounter(&start);
+		int ticks = 0;
+		double elapsed = 0.0;
+		do {
+			remainingNpcs = (LONG)npcCount;
+			for (auto& npc : npcs) SetEvent(npc.hTick);
+			WaitForSingleObject(hTickDone, INFINITE);
+			++ticks;
+			QueryPerformanceCounter(&now);
+			elapsed = (double)(now.QuadPart - start.QuadPart) / frequency.QuadPart;
+		} while (elapsed < seconds);
+		ticksPerSecond = ticks / elapsed;
+	}
+
+	stop = true;
+	for (size_t i = 0; i < threads.size(); ++i) SetEvent(npcs[i].hTick);
+	for (HANDLE h : threads) {
+		WaitForSingleObject(h, INFINITE);
+		CloseHandle(h);
+	}
+	for (auto& npc : npcs) CloseHandle(npc.hTick);
+	CloseHandle(hTickDone);
+	return ticksPerSecond;
+}
+
+double MeasureNpcWorld(size_t npcCount, ParallelForPool* pool, double seconds, UINT64* completedJobs)
+{
+	const float dt = 1.0f / 60.0f;
+	const size_t chunk = 4096;   // 청크 하나 = 약 70KB, L2에 들어가는 크기
+
+	NpcWorld world;
+	world.Reserve(npcCount);
+	for (size_t i = 0; i < npcCount; ++i) {
+		NpcJob job = (NpcJob)(i % kJobCount);
+		world.Add(job, (float)(i % 97) / 97.0f * kJobDuration[job]);
+	}
+
+	std::function<void(size_t, size_t)> tickRange = [&world, dt](size_t begin, size_t end) {
+		world.TickRange(begin, end, dt);
+	};
+
+	LARGE_INTEGER frequency, start, now;
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&start);
+	int ticks = 0;
+	double elapsed = 0.0;
+	do {
+		if (pool) pool->ParallelFor(world.Size(), chunk, tickRange);
+		else world.TickRange(0, world.Size(), dt);
+		++ticks;
+		QueryPerformanceCounter(&now);
+		elapsed = (double)(now.QuadPart - start.QuadPart) / frequency.QuadPart;
+	} while (elapsed < seconds);
+
+	if (completedJobs) *completedJobs = world.TotalCompletedJobs();
+	return ticks / elapsed;
+}
+
+void BenchmarkNpcSimulation()
+{
+	const double seconds = 1.0;
+	const size_t maxThreadPerNpc = 10000;   // 그 이상은 스레드 생성만으로 수 GB 예약 공간과 수십 초가 듦
+
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	int workers = (int)info.dwNumberOfProcessors - 1;   // 호출 스레드도 청크를 처리
+	ParallelForPool pool(workers < 1 ? 1 : workers);
+
+	std::cout << "=== NPC 틱 처리량 (틱/초, 워커 " << pool.GetWorkerCount() << "개 + 호출 스레드) ===" << std::endl;
+	const size_t counts[] = { 10000, 100000, 1000000 };
+	for (size_t count : counts) {
+		std::cout << "NPC " << count << "개" << std::endl;
+
+		if (count <= maxThreadPerNpc) {
+			double tps = MeasureThreadPerNpc(count, seconds);
+			if (tps < 0) std::cout << "  NPC당 스레드   : 스레드 생성 실패" << std::endl;
+			else std::cout << "  NPC당 스레드   : " << (int)tps << std::endl;
+		}
+		else {
+			std::cout << "  NPC당 스레드   : 생략 (" << maxThreadPerNpc << "개 초과)" << std::endl;
+		}
+
+		UINT64 completed = 0;
+		std::cout << "  SoA 단일 스레드: " << (int)MeasureNpcWorld(count, nullptr, seconds, &completed) << std::endl;
+		std::cout << "  SoA 병렬       : " << (int)MeasureNpcWorld(count, &pool, seconds, &completed)
+			<< " (완료한 작업 " << completed << "건)" << std::endl;
+	}
+}
+
+// =============================================================================
+// 고정 시간 간격(fixed timestep) 게임 루프 스케줄러
+// =============================================================================
+// 체력 회복(HealthRecoveryThread), NPC 작업(NPCWorkThread), 액션 처리
+// (gameEngineThread) 예제는 각자 Sleep 타이머로 돌기 때문에 갱신 시점이 서로
+// 어긋나고 한 프레임에 묶어서 처리할 수 없습니다.
+// FixedStepScheduler는 시스템들을 프레임 작업으로 등록받아 정해진 간격(dt)마다
+// 등록 순서대로 실행합니다.
+// - 늦어진 시간은 여러 스텝을 연달아 돌려 따라잡되, 한 번에 kMaxCatchUpSteps까지만
+//   따라잡고 나머지는 버립니다 (갱신이 느려서 더 밀리는 악순환 방지).
+// - 앞 시스템들이 프레임 예산을 다 쓰면 deferrable로 등록된 시스템은 이번 스텝을
+//   건너뛰고, 건너뛴 시간(dt)을 모아 다음 실행 때 한꺼번에 넘깁니다.
+// - 시스템별 실행 시간, 예산 초과 횟수, 스텝 간격의 p50/p99(지터)를 보고합니다.
+#pragma comment(lib, "winmm.lib") // timeBeginPeriod
+
+double Percentile(std::vector<double> values, double ratio)
+{
+	if (values.empty()) return 0.0;
+	std::sort(values.begin(), values.end());
+	size_t index = (size_t)(ratio * (values.size() - 1) + 0.5);
+	return values[index];
+}
+
+class FixedStepScheduler {
+public:
+	typedef std::function<void(double dt)> SystemJob;
+
+private:
+	struct SystemEntry {
+		std::string name;
+		SystemJob job;
+		bool deferrable;
+		double pendingDt;           // 건너뛰는 동안 쌓인 시간
+		std::vector<double> runMs;
+		int skipped;
+	};
+
+	static const int kMaxCatchUpSteps = 5;
+
+	std::vector<SystemEntry> systems;
+	double stepSeconds;
+	double budgetMs;
+	LARGE_INTEGER frequency;
+
+	std::vector<double> updateMs;    // 스텝마다 모든 시스템 실행 시간
+	std::vector<double> intervalMs;  // 스텝 시작 간격 (목표는 stepSeconds)
+	LONGLONG lastStepStart;
+	int overruns;
+	int droppedSteps;
+
+	LONGLONG Now() const
+	{
+		LARGE_INTEGER now;
+		QueryPerformanceCounter(&now);
+		return now.QuadPart;
+	}
+
+	double TicksToMs(LONGLONG ticks) const { return (double)ticks * 1000.0 / frequency.QuadPart; }
+
+	// 2ms 넘게 남았으면 Sleep(1)로, 그 뒤로는 양보하며 목표 시각까지 대기
+	void WaitUntil(LONGLONG target) const
+	{
+		for (;;) {
+			double remainingMs = TicksToMs(target - Now());
+			if (remainingMs <= 0.0) return;
+			if (remainingMs > 2.0) Sleep(1);
+			else SwitchToThread();
+		}
+	}
+
+	void RunStep()
+	{
+		LONGLONG stepStart = Now();
+		if (lastStepStart != 0) intervalMs.push_back(TicksToMs(stepStart - lastStepStart));
+		lastStepStart = stepStart;
+
+		for (auto& system : systems) {
+			double spentMs = TicksToMs(Now() - stepStart);
+			if (system.deferrable && spentMs >= budgetMs) {
+				system.pendingDt += stepSeconds;
+				++system.skipped;
+				continue;
+			}
+
+			double dt = stepSeconds + system.pendingDt;
+			system.pendingDt = 0.0;
+			LONGLONG systemStart = Now();
+			system.job(dt);
+			system.runMs.push_back(TicksToMs(Now() - systemStart));
+		}
+
+		double totalMs = TicksToMs(Now() - stepStart);
+		updateMs.push_back(totalMs);
+		if (totalMs > budgetMs) ++overruns;
+	}
+
+public:
+	// frameBudgetMs가 0이면 스텝 간격 전체를 예산으로 사용
+	explicit FixedStepScheduler(double hz, double frameBudgetMs = 0.0)
+		: stepSeconds(1.0 / hz), budgetMs(frameBudgetMs > 0.0 ? frameBudgetMs : 1000.0 / hz),
+		lastStepStart(0), overruns(0), droppedSteps(0)
+	{
+		QueryPerformanceFrequency(&frequency);
+	}
+
+	void Register(const std::string& name, SystemJob job, bool deferrable = false)
+	{
+		SystemEntry entry;
+		entry.name = name;
+		entry.job = job;
+		entry.deferrable = deferrable;
+		entry.pendingDt = 0.0;
+		entry.skipped = 0;
+		systems.push_back(entry);
+	}
+
+	void Run(double seconds)
+	{
+		timeBeginPeriod(1);   // Sleep(1)이 실제로 1ms 근처에서 깨어나도록
+
+		const LONGLONG step = (LONGLONG)(stepSeconds * frequency.QuadPart);
+		LONGLONG next = Now();
+		const LONGLONG end = next + (LONGLONG)(seconds * frequency.QuadPart);
+
+		while (Now() < end) {
+			WaitUntil(next);
+
+			int steps = 0;
+			while (Now() >= next && steps < kMaxCatchUpSteps) {
+				RunStep();
+				next += step;
+				++steps;
+			}
+
+			// 그래도 밀려 있으면 따라잡지 않고 버림
+			LONGLONG now = Now();
+			if (now >= next) {
+				LONGLONG behind = (now - next) / step + 1;
+				droppedSteps += (int)behind;
+				next += behind * step;
+			}
+		}
+
+		timeEndPeriod(1);
+	}
+
+	void PrintReport() const
+	{
+		std::cout << "  목표 간격 " << stepSeconds * 1000.0 << "ms, 예산 " << budgetMs << "ms, 스텝 "
+			<< updateMs.size() << "회, 예산 초과 " << overruns << "회, 버린 스텝 " << droppedSteps << "회" << std::endl;
+		std::cout << "  스텝 간격 p50 " << Percentile(intervalMs, 0.5) << "ms, p99 " << Percentile(intervalMs, 0.99)
+			<< "ms | 갱신 시간 p50 " << Percentile(updateMs, 0.5) << "ms, p99 " << Percentile(updateMs, 0.99) << "ms" << std::endl;
+		for (const auto& system : systems) {
+			double total = 0.0;
+			for (double ms : system.runMs) total += ms;
+			std::cout << "    " << system.name << ": 실행 " << system.runMs.size() << "회, 평균 "
+				<< (system.runMs.empty() ? 0.0 : total / system.runMs.size()) << "ms, p99 "
+				<< Percentile(system.runMs, 0.99) << "ms";
+			if (system.deferrable) std::cout << ", 미룸 " << system.skipped << "회";
+			std::cout << std::endl;
+		}
+	}
+};
+
+// ----------------------------------------------------------------------------
+// 프레임 작업으로 옮긴 시스템들
+// ----------------------------------------------------------------------------
+// 체력 회복: 초당 regen만큼 회복, 가득 차면 피해를 받은 것으로 보고 다시 깎음
+class HealthRegenSystem {
+private:
+	std::vector<float> health;
+	std::vector<float> maxHealth;
+	std::vector<float> regenPerSecond;
+
+public:
+	explicit HealthRegenSystem(size_t playerCount)
+		: health(playerCount), maxHealth(playerCount, 100.0f), regenPerSecond(playerCount, 10.0f)
+	{
+		for (size_t i = 0; i < playerCount; ++i) health[i] = (float)(30 + i % 70);
+	}
+
+	void Update(double dt)
+	{
+		const float step = (float)dt;
+		for (size_t i = 0; i < health.size(); ++i) {
+			health[i] += regenPerSecond[i] * step;
+			if (health[i] >= maxHealth[i]) health[i] = maxHealth[i] * 0.3f;
+		}
+	}
+};
+
+// 액션 처리: 여러 유닛 스레드가 넣은 액션을 프레임마다 꺼내서 처리
+class ActionSystem {
+private:
+	CRITICAL_SECTION cs;
+	std::vector<int> pending;
+	std::vector<int> processing;
+	long long processedCount;
+	long long checksum;
+
+public:
+	ActionSystem() : processedCount(0), checksum(0) { InitializeCriticalSection(&cs); }
+	~ActionSystem() { DeleteCriticalSection(&cs); }
+
+	void Push(int action)
+	{
+		EnterCriticalSection(&cs);
+		pending.push_back(action);
+		LeaveCriticalSection(&cs);
+	}
+
+	// 잠금 안에서는 버퍼만 바꾸고 처리는 밖에서
+	void Update(double)
+	{
+		EnterCriticalSection(&cs);
+		pending.swap(processing);
+		LeaveCriticalSection(&cs);
+
+		for (int action : processing) checksum += action % 7;
+		processedCount += (long long)processing.size();
+		processing.clear();
+	}
+
+	long long GetProcessedCount() const { return processedCount; }
+};
+
+struct ActionProducerParam {
+	ActionSystem* actions;
+	int unitId;
+	volatile bool* stop;
+};
+
+unsigned __stdcall ActionProducerThread(void* param)
+{
+	ActionProducerParam* p = static_cast<ActionProducerParam*>(param);
+	int sequence = 0;
+	while (!*p->stop) {
+		for (int i = 0; i < 50; ++i) p->actions->Push(p->unitId * 100000 + sequence++);
+		Sleep(1);
+	}
+	return 0;
+}
+
+// 60Hz, 240Hz에서 세 시스템을 함께 돌리며 예산/지터 측정
+void BenchmarkGameLoop()
+{
+	const double seconds = 3.0;
+	const size_t npcCount = 2000000;
+	const size_t playerCount = 1000000;
+	const int producerCount = 3;
+
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	int workers = (int)info.dwNumberOfProcessors - 1;
+	ParallelForPool pool(workers < 1 ? 1 : workers);
+
+	NpcWorld world;
+	world.Reserve(npcCount);
+	for (size_t i = 0; i < npcCount; ++i) world.Add((NpcJob)(i % kJobCount), 0.0f);
+	HealthRegenSystem health(playerCount);
+	ActionSystem actions;
+
+	const double rates[] = { 60.0, 240.0 };
+	for (double hz : rates) {
+		volatile bool stop = false;
+		std::vector<ActionProducerParam> params(producerCount);
+		std::vector<HANDLE> producers;
+		for (int i = 0; i < producerCount; ++i) {
+			params[i] = { &actions, i + 1, &stop };
+			HANDLE hThread = (HANDLE)_beginthreadex(nullptr, 0, ActionProducerThread, &params[i], 0, nullptr);
+			if (hThread) producers.push_back(hThread);
+		}
+
+		FixedStepScheduler scheduler(hz);
+		scheduler.Register("액션 처리", [&actions](double dt) { actions.Update(dt); });
+		scheduler.Register("체력 회복", [&health](double dt) { health.Update(dt); });
+		scheduler.Register("NPC 작업", [&world, &pool](double dt) {
+			pool.ParallelFor(world.Size(), 4096, [&world, dt](size_t begin, size_t end) {
+				world.TickRange(begin, end, (float)dt);
+			});
+		}, true);   // NPC는 한두 프레임 늦어도 되므로 예산이 모자라면 미룸
+
+		long long processedBefore = actions.GetProcessedCount();
+		scheduler.Run(seconds);
+
+		stop = true;
+		WaitForMultipleObjects((DWORD)producers.size(), producers.data(), TRUE, INFINITE);
+		for (HANDLE h : producers) CloseHandle(h);
+
+		std::cout << "=== " << hz << "Hz (NPC " << npcCount << ", 플레이어 " << playerCount << ", 액션 생산 스레드 "
+			<< producerCount << "개, " << seconds << "초) ===" << std::endl;
+		scheduler.PrintReport();
+		std::cout << "  처리한 액션 " << actions.GetProcessedCount() - processedBefore << "개" << std::endl;
+	}
+}
+
+int main(int argc, char* argv[]) {
+	if (argc > 1 && strcmp(argv[1], "--bench-npc") == 0) {
+		BenchmarkNpcSimulation();
+		return 0;
+	}
+	if (argc > 1 && strcmp(argv[1], "--bench-gameloop") == 0) {
+		BenchmarkGameLoop();
+		return 0;
+	}
+
 	// NPC 데이터 설정
 	NPCData npcs[3] = {
 		{"상인 앤", "상점 운영", 3},
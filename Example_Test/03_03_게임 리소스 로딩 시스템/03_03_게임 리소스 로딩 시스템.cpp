@@ -2,6 +2,13 @@
 #include <windows.h>
 #include <process.h>
 #include <string>
+#include <vector>
+#include <deque>
+#include <cstring>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <unordered_map>
 
 struct ResourceData
 {
@@ -32,8 +39,1838 @@ unsigned __stdcall ResourceLoadThread(void* param)
 	return 0;
 }
 
-int main()
+// =============================================================================
+// 우선순위 리소스 로더: I/O 스레드 풀 + 디코드(CPU) 스레드 풀
+// =============================================================================
+// 위 예제는 리소스마다 스레드를 하나씩 만들고 Sleep으로 로딩을 흉내 냅니다.
+// 아래 로더는 실제 파일을 읽는 작은 I/O 풀과, 읽은 데이터를 풀고(RLE) 디코드하는
+// CPU 풀로 나눠 처리합니다. 두 큐 모두 필수(isEssential) 항목을 먼저 꺼내므로
+// 일반 리소스가 아무리 많이 쌓여 있어도 필수 세트가 먼저 준비되고,
+// 필수 항목이 모두 끝나는 순간 essentialReady 이벤트가 켜집니다.
+
+// 에셋 파일 = AssetHeader + RLE 데이터 (길이 1바이트, 값 1바이트) 쌍
+const UINT32 kAssetMagic = 0x54455341; // "ASET"
+
+struct AssetHeader
+{
+	UINT32 magic;
+	UINT32 rawSize;      // 풀었을 때 크기
+	UINT32 packedSize;   // RLE 데이터 크기
+	UINT32 checksum;     // 풀린 데이터의 FNV-1a
+};
+
+UINT32 Fnv1a(const char* data, size_t size)
+{
+	UINT32 hash = 2166136261u;
+	for (size_t i = 0; i < size; ++i) {
+		hash ^= (unsigned char)data[i];
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+struct LoadRequest
+{
+	std::string name;
+	std::string path;
+	bool isEssential;
+	std::vector<char> fileBytes;   // I/O 단계 결과 (압축된 상태)
+	std::vector<char> data;        // 디코드 단계 결과
+	const char* mapped;            // 아카이브의 원본 항목이면 매핑된 메모리 (이때 data는 비어 있음)
+	size_t mappedSize;
+	bool isLoaded;
+	bool failed;
+	double readyMs;                // 제출부터 사용 가능해질 때까지
+};
+
+bool ReadAssetFile(LoadRequest& request)
+{
+	HANDLE hFile = CreateFileA(request.path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+		OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (hFile == INVALID_HANDLE_VALUE) return false;
+
+	LARGE_INTEGER size;
+	bool ok = GetFileSizeEx(hFile, &size) != FALSE;
+	if (ok) {
+		request.fileBytes.resize((size_t)size.QuadPart);
+		size_t total = 0;
+		while (ok && total < request.fileBytes.size()) {
+			DWORD bytesRead = 0;
+			ok = ReadFile(hFile, &request.fileBytes[total], (DWORD)(request.fileBytes.size() - total), &bytesRead, NULL) && bytesRead > 0;
+			total += bytesRead;
+		}
+	}
+	CloseHandle(hFile);
+	return ok;
+}
+
+// (길이, 값) 쌍을 풀어서 정확히 rawSize 바이트가 나와야 성공
+bool ExpandRle(const char* packed, size_t packedSize, size_t rawSize, std::vector<char>& out)
+{
+	out.resize(rawSize);
+	size_t written = 0;
+	for (size_t in = 0; in + 1 < packedSize; in += 2) {
+		size_t run = (unsigned char)packed[in];
+		if (written + run > rawSize) return false;
+		memset(&out[written], packed[in + 1], run);
+		written += run;
+	}
+	return written == rawSize;
+}
+
+// RLE를 풀고 체크섬으로 검증 (텍스처 디코드 같은 CPU 작업 역할)
+bool DecodeAsset(LoadRequest& request)
+{
+	const std::vector<char>& packed = request.fileBytes;
+	if (packed.size() < sizeof(AssetHeader)) return false;
+
+	AssetHeader header;
+	memcpy(&header, packed.data(), sizeof(header));
+	if (header.magic != kAssetMagic || header.packedSize != packed.size() - sizeof(AssetHeader)) return false;
+
+	if (!ExpandRle(packed.data() + sizeof(AssetHeader), header.packedSize, header.rawSize, request.data)) return false;
+
+	request.fileBytes.clear();
+	request.fileBytes.shrink_to_fit();
+	return Fnv1a(request.data.data(), request.data.size()) == header.checksum;
+}
+
+// 필수 항목용 큐와 일반 항목용 큐를 두고 필수부터 꺼내는 작업 큐
+class PriorityJobQueue
+{
+private:
+	CRITICAL_SECTION cs;
+	CONDITION_VARIABLE cv;
+	std::deque<LoadRequest*> essential;
+	std::deque<LoadRequest*> normal;
+	bool closed;
+
+public:
+	PriorityJobQueue() : closed(false)
+	{
+		InitializeCriticalSection(&cs);
+		InitializeConditionVariable(&cv);
+	}
+	~PriorityJobQueue() { DeleteCriticalSection(&cs); }
+
+	void Push(LoadRequest* request, bool urgent)
+	{
+		EnterCriticalSection(&cs);
+		(urgent ? essential : normal).push_back(request);
+		LeaveCriticalSection(&cs);
+		WakeConditionVariable(&cv);
+	}
+
+	// 큐가 닫히고 비어 있으면 false
+	bool Pop(LoadRequest*& request)
+	{
+		EnterCriticalSection(&cs);
+		while (essential.empty() && normal.empty() && !closed) {
+			SleepConditionVariableCS(&cv, &cs, INFINITE);
+		}
+		bool ok = true;
+		if (!essential.empty()) {
+			request = essential.front();
+			essential.pop_front();
+		}
+		else if (!normal.empty()) {
+			request = normal.front();
+			normal.pop_front();
+		}
+		else ok = false;
+		LeaveCriticalSection(&cs);
+		return ok;
+	}
+
+	void Close()
+	{
+		EnterCriticalSection(&cs);
+		closed = true;
+		LeaveCriticalSection(&cs);
+		WakeAllConditionVariable(&cv);
+	}
+};
+
+// 아카이브 소스 (정의는 아래 아카이브 절에 있음)
+class PackedArchive;
+bool DecodeArchiveAsset(const PackedArchive& archive, LoadRequest& request);
+
+// archive를 주면 개별 파일 대신 매핑된 아카이브에서 읽음. 이미 메모리에 매핑되어
+// 있으므로 I/O 단계를 건너뛰고 바로 디코드 큐로 보냄
+class ResourceLoader
+{
+private:
+	const PackedArchive* archive;
+	PriorityJobQueue ioQueue;
+	PriorityJobQueue decodeQueue;
+	std::vector<HANDLE> ioThreads;
+	std::vector<HANDLE> decodeThreads;
+	bool prioritize;
+
+	volatile LONG essentialRemaining;
+	volatile LONG allRemaining;
+	HANDLE hEssentialReady;   // 필수 리소스가 모두 준비되면 신호 (수동 리셋)
+	HANDLE hAllLoaded;
+
+	LARGE_INTEGER frequency;
+	LARGE_INTEGER submitTick;
+
+	bool IsUrgent(const LoadRequest& request) const { return prioritize && request.isEssential; }
+
+	static unsigned __stdcall IoThread(void* param)
+	{
+		ResourceLoader* loader = (ResourceLoader*)param;
+		LoadRequest* request;
+		while (loader->ioQueue.Pop(request)) {
+			if (ReadAssetFile(*request)) {
+				loader->decodeQueue.Push(request, loader->IsUrgent(*request));
+			}
+			else {
+				request->failed = true;
+				loader->Finish(*request);
+			}
+		}
+		return 0;
+	}
+
+	static unsigned __stdcall DecodeThread(void* param)
+	{
+		ResourceLoader* loader = (ResourceLoader*)param;
+		LoadRequest* request;
+		while (loader->decodeQueue.Pop(request)) {
+			bool ok = loader->archive ? DecodeArchiveAsset(*loader->archive, *request) : DecodeAsset(*request);
+			if (ok) request->isLoaded = true;
+			else request->failed = true;
+			loader->Finish(*request);
+		}
+		return 0;
+	}
+
+	void Finish(LoadRequest& request)
+	{
+		LARGE_INTEGER now;
+		QueryPerformanceCounter(&now);
+		request.readyMs = (double)(now.QuadPart - submitTick.QuadPart) * 1000.0 / frequency.QuadPart;
+
+		if (request.isEssential && InterlockedDecrement(&essentialRemaining) == 0) {
+			SetEvent(hEssentialReady);
+		}
+		if (InterlockedDecrement(&allRemaining) == 0) {
+			SetEvent(hAllLoaded);
+		}
+	}
+
+public:
+	ResourceLoader(int ioThreadCount, int decodeThreadCount, bool prioritizeEssential = true, const PackedArchive* source = nullptr)
+		: archive(source), prioritize(prioritizeEssential), essentialRemaining(0), allRemaining(0)
+	{
+		QueryPerformanceFrequency(&frequency);
+		submitTick.QuadPart = 0;
+		hEssentialReady = CreateEvent(NULL, TRUE, FALSE, NULL);
+		hAllLoaded = CreateEvent(NULL, TRUE, FALSE, NULL);
+
+		for (int i = 0; i < ioThreadCount; ++i) {
+			HANDLE hThread = (HANDLE)_beginthreadex(NULL, 0, IoThread, this, 0, NULL);
+			if (hThread) ioThreads.push_back(hThread);
+		}
+		for (int i = 0; i < decodeThreadCount; ++i) {
+			HANDLE hThread = (HANDLE)_beginthreadex(NULL, 0, DecodeThread, this, 0, NULL);
+			if (hThread) decodeThreads.push_back(hThread);
+		}
+	}
+
+	~ResourceLoader()
+	{
+		// I/O 풀이 먼저 끝나야 디코드 큐에 더 들어오는 항목이 없음
+		ioQueue.Close();
+		for (HANDLE h : ioThreads) {
+			WaitForSingleObject(h, INFINITE);
+			CloseHandle(h);
+		}
+		decodeQueue.Close();
+		for (HANDLE h : decodeThreads) {
+			WaitForSingleObject(h, INFINITE);
+			CloseHandle(h);
+		}
+		CloseHandle(hEssentialReady);
+		CloseHandle(hAllLoaded);
+	}
+
+	// 한 번에 하나의 리소스 세트를 제출 (카운터를 먼저 잡아야 이벤트가 일찍 켜지지 않음)
+	// 같은 로더로 다음 세트를 제출하려면 이전 세트의 전체 로딩 이벤트가 켜진 뒤에 호출
+	void Submit(std::vector<LoadRequest>& requests)
+	{
+		LONG essentialCount = 0;
+		for (const auto& request : requests) {
+			if (request.isEssential) ++essentialCount;
+		}
+		// 수동 리셋 이벤트라 이전 세트에서 켜진 상태가 남아 있음. 새 카운터를 공개하기 전에 끔
+		ResetEvent(hEssentialReady);
+		ResetEvent(hAllLoaded);
+		essentialRemaining = essentialCount;
+		allRemaining = (LONG)requests.size();
+		if (essentialCount == 0) SetEvent(hEssentialReady);
+		if (requests.empty()) SetEvent(hAllLoaded);
+
+		QueryPerformanceCounter(&submitTick);
+		for (auto& request : requests) {
+			request.isLoaded = false;
+			request.failed = false;
+			request.mapped = nullptr;
+			request.mappedSize = 0;
+			(archive ? decodeQueue : ioQueue).Push(&request, IsUrgent(request));
+		}
+	}
+
+	HANDLE GetEssentialReadyEvent() const { return hEssentialReady; }
+	HANDLE GetAllLoadedEvent() const { return hAllLoaded; }
+};
+
+// ----------------------------------------------------------------------------
+// 합성 에셋 세트와 로딩 시간 비교
+// ----------------------------------------------------------------------------
+// 작은 LCG (매번 같은 에셋 세트를 만들기 위해)
+UINT32 NextRandom(UINT32& state)
+{
+	state = state * 1664525u + 1013904223u;
+	return state >> 8;
+}
+
+bool WriteSyntheticAsset(const std::string& path, UINT32 rawSize, UINT32& seed)
+{
+	std::vector<char> raw(rawSize);
+	std::vector<char> packed;
+	packed.reserve(rawSize / 8);
+	for (UINT32 i = 0; i < rawSize;) {
+		UINT32 run = 1 + NextRandom(seed) % 32;
+		if (run > rawSize - i) run = rawSize - i;
+		char value = (char)NextRandom(seed);
+		memset(&raw[i], value, run);
+		packed.push_back((char)run);
+		packed.push_back(value);
+		i += run;
+	}
+
+	AssetHeader header = { kAssetMagic, rawSize, (UINT32)packed.size(), Fnv1a(raw.data(), raw.size()) };
+	HANDLE hFile = CreateFileA(path.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (hFile == INVALID_HANDLE_VALUE) return false;
+	DWORD written = 0;
+	bool ok = WriteFile(hFile, &header, sizeof(header), &written, NULL) &&
+		WriteFile(hFile, packed.data(), (DWORD)packed.size(), &written, NULL);
+	CloseHandle(hFile);
+	return ok;
+}
+
+// 필수 리소스는 작은 것 위주로 약 10%, 목록 안에 흩어 놓음
+std::vector<LoadRequest> CreateSyntheticAssets(const std::string& directory, int count)
+{
+	std::vector<LoadRequest> requests;
+	UINT32 seed = 12345;
+	CreateDirectoryA(directory.c_str(), NULL);
+
+	for (int i = 0; i < count; ++i) {
+		LoadRequest request = {};
+		request.name = "asset_" + std::to_string(i);
+		request.path = directory + request.name + ".bin";
+		request.isEssential = (NextRandom(seed) % 10) == 0;
+
+		UINT32 rawSize = request.isEssential
+			? 64 * 1024 + NextRandom(seed) % (256 * 1024)
+			: 64 * 1024 + NextRandom(seed) % (2 * 1024 * 1024);
+		if (!WriteSyntheticAsset(request.path, rawSize, seed)) {
+			std::cout << "에셋 생성 실패: " << request.path << std::endl;
+			break;
+		}
+		requests.push_back(request);
+	}
+	return requests;
+}
+
+void DeleteSyntheticAssets(const std::string& directory, const std::vector<LoadRequest>& requests)
+{
+	for (const auto& request : requests) DeleteFileA(request.path.c_str());
+	RemoveDirectoryA(directory.c_str());
+}
+
+unsigned __stdcall LoadAssetThread(void* param)
+{
+	LoadRequest* request = (LoadRequest*)param;
+	request->isLoaded = ReadAssetFile(*request) && DecodeAsset(*request);
+	request->failed = !request->isLoaded;
+	return 0;
+}
+
+// WaitForMultipleObjects는 한 번에 MAXIMUM_WAIT_OBJECTS(64)개까지만 기다릴 수 있음
+void WaitForAllHandles(const std::vector<HANDLE>& handles)
+{
+	for (size_t i = 0; i < handles.size(); i += MAXIMUM_WAIT_OBJECTS) {
+		size_t remaining = handles.size() - i;
+		DWORD count = (DWORD)(remaining < MAXIMUM_WAIT_OBJECTS ? remaining : MAXIMUM_WAIT_OBJECTS);
+		WaitForMultipleObjects(count, &handles[i], TRUE, INFINITE);
+	}
+}
+
+struct LoadTimings
+{
+	double playableMs;   // 필수 리소스가 모두 준비될 때까지
+	double allLoadedMs;  // 모든 리소스가 준비될 때까지
+	int failed;
+};
+
+double ElapsedMs(const LARGE_INTEGER& start)
+{
+	LARGE_INTEGER now, frequency;
+	QueryPerformanceCounter(&now);
+	QueryPerformanceFrequency(&frequency);
+	return (double)(now.QuadPart - start.QuadPart) * 1000.0 / frequency.QuadPart;
+}
+
+// 기존 방식: 리소스마다 스레드 하나
+LoadTimings LoadWithThreadPerResource(std::vector<LoadRequest>& requests)
+{
+	LoadTimings timings = {};
+	LARGE_INTEGER start;
+	QueryPerformanceCounter(&start);
+
+	std::vector<HANDLE> all, essential;
+	for (auto& request : requests) {
+		HANDLE hThread = (HANDLE)_beginthreadex(NULL, 0, LoadAssetThread, &request, 0, NULL);
+		if (hThread == NULL) continue;
+		all.push_back(hThread);
+		if (request.isEssential) essential.push_back(hThread);
+	}
+
+	WaitForAllHandles(essential);
+	timings.playableMs = ElapsedMs(start);
+	WaitForAllHandles(all);
+	timings.allLoadedMs = ElapsedMs(start);
+
+	for (HANDLE h : all) CloseHandle(h);
+	for (const auto& request : requests) {
+		if (request.failed) ++timings.failed;
+	}
+	return timings;
+}
+
+LoadTimings LoadWithPools(std::vector<LoadRequest>& requests, int ioThreads, int decodeThreads, bool prioritize,
+	const PackedArchive* archive = nullptr)
+{
+	LoadTimings timings = {};
+	ResourceLoader loader(ioThreads, decodeThreads, prioritize, archive);
+
+	LARGE_INTEGER start;
+	QueryPerformanceCounter(&start);
+	loader.Submit(requests);
+
+	WaitForSingleObject(loader.GetEssentialReadyEvent(), INFINITE);
+	timings.playableMs = ElapsedMs(start);
+	WaitForSingleObject(loader.GetAllLoadedEvent(), INFINITE);
+	timings.allLoadedMs = ElapsedMs(start);
+
+	for (const auto& request : requests) {
+		if (request.failed) ++timings.failed;
+	}
+	return timings;
+}
+
+void PrintLoadTimings(const char* label, const LoadTimings& timings)
+{
+	std::cout << label << " : 플레이 가능 " << (int)timings.playableMs << "ms, 전체 로딩 "
+		<< (int)timings.allLoadedMs << "ms";
+	if (timings.failed > 0) std::cout << " (실패 " << timings.failed << "개)";
+	std::cout << std::endl;
+}
+
+void BenchmarkLoader()
+{
+	const int assetCount = 300;
+	char tempPath[MAX_PATH];
+	GetTempPathA(MAX_PATH, tempPath);
+	std::string directory = std::string(tempPath) + "mt_loader_assets\\";
+
+	std::vector<LoadRequest> assets = CreateSyntheticAssets(directory, assetCount);
+	int essentialCount = 0;
+	for (const auto& asset : assets) {
+		if (asset.isEssential) ++essentialCount;
+	}
+
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	int decodeThreads = info.dwNumberOfProcessors < 2 ? 2 : (int)info.dwNumberOfProcessors;
+	const int ioThreads = 2;
+
+	std::cout << "=== 리소스 로딩: 에셋 " << assets.size() << "개 (필수 " << essentialCount
+		<< "개), I/O " << ioThreads << " + 디코드 " << decodeThreads << " 스레드 ===" << std::endl;
+	std::cout << "(방금 만든 파일이라 OS 파일 캐시에 올라와 있는 상태입니다)" << std::endl;
+
+	std::vector<LoadRequest> requests = assets;
+	PrintLoadTimings("리소스마다 스레드     ", LoadWithThreadPerResource(requests));
+
+	requests = assets;
+	PrintLoadTimings("풀 + 제출 순서(FIFO)  ", LoadWithPools(requests, ioThreads, decodeThreads, false));
+
+	requests = assets;
+	PrintLoadTimings("풀 + 필수 우선        ", LoadWithPools(requests, ioThreads, decodeThreads, true));
+
+	DeleteSyntheticAssets(directory, assets);
+}
+
+// =============================================================================
+// 패킹된 에셋 아카이브 (.pak)
+// =============================================================================
+// 작은 리소스가 수천 개면 파일을 열고 닫는 비용이 실제 읽기보다 커집니다.
+// 아카이브는 여러 에셋을 파일 하나에 모으고, 앞쪽 인덱스에 이름 해시/위치/크기/
+// 압축 방식을 해시 순으로 정렬해 둡니다. 로더는 파일 전체를 MapViewOfFile로
+// 매핑한 뒤 이진 탐색으로 항목을 찾고, 압축하지 않은 항목은 복사 없이 매핑된
+// 메모리를 그대로 가리키는 뷰를 돌려줍니다.
+//
+// 파일 형식 (리틀 엔디언)
+//   ArchiveHeader
+//   ArchiveEntry[entryCount]   (nameHash 오름차순)
+//   데이터 (항목마다 16바이트 정렬)
+const UINT32 kArchiveMagic = 0x314B4150; // "PAK1"
+const UINT32 kArchiveVersion = 1;
+const UINT32 kArchiveAlignment = 16;
+const UINT32 kArchiveStoreThreshold = 64 * 1024; // 이보다 작은 항목은 기본적으로 압축하지 않음
+
+enum ArchiveCompression : UINT32
+{
+	kArchiveStored = 0,   // 원본 그대로 (매핑된 메모리를 바로 사용)
+	kArchiveRle = 1       // RLE (길이, 값) 쌍
+};
+
+struct ArchiveHeader
+{
+	UINT32 magic;
+	UINT32 version;
+	UINT32 entryCount;
+	UINT32 reserved;
+};
+
+struct ArchiveEntry
+{
+	UINT64 nameHash;
+	UINT64 offset;       // 파일 시작 기준
+	UINT32 storedSize;   // 아카이브 안에서 차지하는 크기
+	UINT32 rawSize;      // 풀었을 때 크기
+	UINT32 compression;
+	UINT32 checksum;     // 풀린 데이터의 FNV-1a
+};
+
+UINT64 HashAssetName(const std::string& name)
 {
+	UINT64 hash = 14695981039346656037ull;
+	for (char c : name) {
+		hash ^= (unsigned char)c;
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+void CompressRle(const char* raw, size_t size, std::vector<char>& packed)
+{
+	packed.clear();
+	for (size_t i = 0; i < size;) {
+		size_t run = 1;
+		while (i + run < size && run < 255 && raw[i + run] == raw[i]) ++run;
+		packed.push_back((char)run);
+		packed.push_back(raw[i]);
+		i += run;
+	}
+}
+
+// 아카이브 빌더: 항목을 모았다가 Write에서 인덱스를 정렬해 한 번에 기록
+class ArchiveBuilder
+{
+private:
+	struct PendingEntry
+	{
+		std::string name;
+		ArchiveEntry entry;
+		std::vector<char> stored;
+	};
+	std::vector<PendingEntry> entries;
+
+public:
+	// compress가 true여도 RLE가 더 크면 원본으로 저장
+	bool Add(const std::string& name, const char* raw, size_t size, bool compress)
+	{
+		PendingEntry pending;
+		pending.name = name;
+		pending.entry.nameHash = HashAssetName(name);
+		pending.entry.offset = 0;
+		pending.entry.rawSize = (UINT32)size;
+		pending.entry.checksum = Fnv1a(raw, size);
+		pending.entry.compression = kArchiveStored;
+
+		if (compress) CompressRle(raw, size, pending.stored);
+		if (compress && pending.stored.size() < size) {
+			pending.entry.compression = kArchiveRle;
+		}
+		else {
+			pending.stored.assign(raw, raw + size);
+		}
+		pending.entry.storedSize = (UINT32)pending.stored.size();
+		entries.push_back(std::move(pending));
+		return true;
+	}
+
+	// 로더용 에셋 파일(AssetHeader + RLE)을 풀어서 추가
+	bool AddAssetFile(const std::string& name, const std::string& path, bool compress)
+	{
+		LoadRequest request = {};
+		request.path = path;
+		if (!ReadAssetFile(request) || !DecodeAsset(request)) {
+			std::cout << "에셋을 읽을 수 없습니다: " << path << std::endl;
+			return false;
+		}
+		return Add(name, request.data.data(), request.data.size(), compress);
+	}
+
+	bool Write(const std::string& path)
+	{
+		std::sort(entries.begin(), entries.end(), [](const PendingEntry& a, const PendingEntry& b) {
+			return a.entry.nameHash < b.entry.nameHash;
+		});
+		for (size_t i = 1; i < entries.size(); ++i) {
+			if (entries[i].entry.nameHash == entries[i - 1].entry.nameHash) {
+				std::cout << "이름 해시 충돌: " << entries[i - 1].name << ", " << entries[i].name << std::endl;
+				return false;
+			}
+		}
+
+		UINT64 offset = sizeof(ArchiveHeader) + entries.size() * sizeof(ArchiveEntry);
+		std::vector<ArchiveEntry> index;
+		for (auto& pending : entries) {
+			offset = (offset + kArchiveAlignment - 1) & ~(UINT64)(kArchiveAlignment - 1);
+			pending.entry.offset = offset;
+			offset += pending.entry.storedSize;
+			index.push_back(pending.entry);
+		}
+
+		HANDLE hFile = CreateFileA(path.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (hFile == INVALID_HANDLE_VALUE) {
+			std::cout << "아카이브를 만들 수 없습니다: " << path << std::endl;
+			return false;
+		}
+
+		// 데이터는 메모리에서 이어 붙인 뒤 큰 단위로 기록
+		ArchiveHeader header = { kArchiveMagic, kArchiveVersion, (UINT32)entries.size(), 0 };
+		std::string buffer((const char*)&header, sizeof(header));
+		if (!index.empty()) buffer.append((const char*)index.data(), index.size() * sizeof(ArchiveEntry));
+		for (const auto& pending : entries) {
+			buffer.resize((size_t)pending.entry.offset, '\0');
+			buffer.append(pending.stored.data(), pending.stored.size());
+		}
+
+		bool ok = true;
+		for (size_t written = 0; ok && written < buffer.size();) {
+			DWORD chunk = (DWORD)(buffer.size() - written < (1u << 30) ? buffer.size() - written : (1u << 30));
+			DWORD bytesWritten = 0;
+			ok = WriteFile(hFile, buffer.data() + written, chunk, &bytesWritten, NULL) && bytesWritten > 0;
+			written += bytesWritten;
+		}
+		CloseHandle(hFile);
+		return ok;
+	}
+
+	size_t GetEntryCount() const { return entries.size(); }
+};
+
+// 항목 하나에 대한 뷰. data는 매핑된 메모리를 가리키므로 아카이브가 열려 있는 동안만 유효
+struct ArchiveView
+{
+	const char* data;
+	UINT32 storedSize;
+	UINT32 rawSize;
+	UINT32 compression;
+	UINT32 checksum;
+};
+
+class PackedArchive
+{
+private:
+	HANDLE hFile;
+	HANDLE hMapping;
+	const char* base;
+	UINT64 fileSize;
+	const ArchiveEntry* index;
+	UINT32 entryCount;
+
+public:
+	PackedArchive() : hFile(INVALID_HANDLE_VALUE), hMapping(NULL), base(nullptr), fileSize(0), index(nullptr), entryCount(0) {}
+	~PackedArchive() { Close(); }
+
+	bool Open(const std::string& path)
+	{
+		Close();
+		hFile = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, NULL);
+		if (hFile == INVALID_HANDLE_VALUE) return false;
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(hFile, &size) || size.QuadPart < (LONGLONG)sizeof(ArchiveHeader)) {
+			Close();
+			return false;
+		}
+		fileSize = (UINT64)size.QuadPart;
+
+		hMapping = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (hMapping != NULL) base = (const char*)MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+		if (base == nullptr) {
+			Close();
+			return false;
+		}
+
+		const ArchiveHeader* header = (const ArchiveHeader*)base;
+		if (header->magic != kArchiveMagic || header->version != kArchiveVersion ||
+			(fileSize - sizeof(ArchiveHeader)) / sizeof(ArchiveEntry) < header->entryCount) {
+			Close();
+			return false;
+		}
+		index = (const ArchiveEntry*)(base + sizeof(ArchiveHeader));
+		entryCount = header->entryCount;
+		return true;
+	}
+
+	void Close()
+	{
+		if (base) UnmapViewOfFile(base);
+		if (hMapping) CloseHandle(hMapping);
+		if (hFile != INVALID_HANDLE_VALUE) CloseHandle(hFile);
+		base = nullptr;
+		hMapping = NULL;
+		hFile = INVALID_HANDLE_VALUE;
+		index = nullptr;
+		entryCount = 0;
+	}
+
+	// 인덱스를 이진 탐색해서 뷰를 돌려줌 (데이터 복사 없음)
+	bool Find(const std::string& name, ArchiveView& view) const
+	{
+		UINT64 hash = HashAssetName(name);
+		UINT32 low = 0, high = entryCount;
+		while (low < high) {
+			UINT32 mid = low + (high - low) / 2;
+			if (index[mid].nameHash < hash) low = mid + 1;
+			else high = mid;
+		}
+		if (low == entryCount || index[low].nameHash != hash) return false;
+
+		const ArchiveEntry& entry = index[low];
+		if (entry.offset > fileSize || entry.storedSize > fileSize - entry.offset) return false;
+		view.data = base + entry.offset;
+		view.storedSize = entry.storedSize;
+		view.rawSize = entry.rawSize;
+		view.compression = entry.compression;
+		view.checksum = entry.checksum;
+		return true;
+	}
+
+	// 압축된 항목을 풀어서 out에 복사 (원본 항목이면 그대로 복사)
+	static bool Extract(const ArchiveView& view, std::vector<char>& out)
+	{
+		if (view.compression == kArchiveStored) {
+			out.assign(view.data, view.data + view.storedSize);
+			return true;
+		}
+		if (view.compression == kArchiveRle) {
+			return ExpandRle(view.data, view.storedSize, view.rawSize, out);
+		}
+		return false;
+	}
+
+	UINT32 GetEntryCount() const { return entryCount; }
+	const ArchiveEntry* GetIndex() const { return index; }
+};
+
+// ResourceLoader의 디코드 단계 (아카이브 소스)
+// 원본 항목은 체크섬만 확인하고 매핑된 메모리를 그대로 넘기고, RLE 항목만 풀어서 data에 둠
+bool DecodeArchiveAsset(const PackedArchive& archive, LoadRequest& request)
+{
+	ArchiveView view;
+	if (!archive.Find(request.name, view)) return false;
+
+	if (view.compression == kArchiveStored) {
+		if (view.storedSize != view.rawSize) return false;
+		request.mapped = view.data;
+		request.mappedSize = view.storedSize;
+		return Fnv1a(view.data, view.storedSize) == view.checksum;
+	}
+	if (!PackedArchive::Extract(view, request.data)) return false;
+	return Fnv1a(request.data.data(), request.data.size()) == view.checksum;
+}
+
+// 빌더 도구: --pack <아카이브> <에셋 파일...>, --list <아카이브>
+std::string AssetNameFromPath(const std::string& path)
+{
+	size_t slash = path.find_last_of("\\/");
+	std::string name = (slash == std::string::npos) ? path : path.substr(slash + 1);
+	size_t dot = name.find_last_of('.');
+	return (dot == std::string::npos) ? name : name.substr(0, dot);
+}
+
+int PackArchiveCommand(int argc, char* argv[])
+{
+	ArchiveBuilder builder;
+	for (int i = 3; i < argc; ++i) {
+		if (!builder.AddAssetFile(AssetNameFromPath(argv[i]), argv[i], true)) return 1;
+	}
+	if (!builder.Write(argv[2])) return 1;
+	std::cout << argv[2] << ": 항목 " << builder.GetEntryCount() << "개를 기록했습니다." << std::endl;
+	return 0;
+}
+
+int ListArchiveCommand(const char* path)
+{
+	PackedArchive archive;
+	if (!archive.Open(path)) {
+		std::cout << "아카이브를 열 수 없습니다: " << path << std::endl;
+		return 1;
+	}
+	for (UINT32 i = 0; i < archive.GetEntryCount(); ++i) {
+		const ArchiveEntry& entry = archive.GetIndex()[i];
+		std::cout << std::hex << entry.nameHash << std::dec << "  offset " << entry.offset
+			<< "  " << entry.storedSize << " / " << entry.rawSize << " bytes  "
+			<< (entry.compression == kArchiveRle ? "RLE" : "stored") << std::endl;
+	}
+	return 0;
+}
+
+// ----------------------------------------------------------------------------
+// 개별 파일 vs 아카이브 로딩 비교
+// ----------------------------------------------------------------------------
+// "첫 패스"는 아카이브를 새로 열고 매핑하는 비용과 첫 접근 페이지 폴트를 포함합니다.
+// 두 번째 패스는 이미 매핑된 상태를 다시 읽습니다. 방금 만든 파일이라 OS 파일
+// 캐시는 양쪽 모두 데워져 있습니다 (디스크까지 가는 진짜 cold 측정은 재부팅이나
+// 대기 목록 비우기가 필요합니다).
+struct ArchiveBenchResult
+{
+	double firstPassMs;
+	double secondPassMs;
+	UINT32 checksum;
+	int failed;
+};
+
+ArchiveBenchResult LoadLooseAssets(const std::vector<LoadRequest>& assets)
+{
+	ArchiveBenchResult result = {};
+	for (int pass = 0; pass < 2; ++pass) {
+		LARGE_INTEGER start;
+		QueryPerformanceCounter(&start);
+		UINT32 checksum = 0;
+		for (const auto& asset : assets) {
+			LoadRequest request = {};
+			request.path = asset.path;
+			if (ReadAssetFile(request) && DecodeAsset(request)) checksum ^= Fnv1a(request.data.data(), request.data.size());
+			else ++result.failed;
+		}
+		(pass == 0 ? result.firstPassMs : result.secondPassMs) = ElapsedMs(start);
+		result.checksum = checksum;
+	}
+	return result;
+}
+
+ArchiveBenchResult LoadFromArchive(const std::string& path, const std::vector<LoadRequest>& assets)
+{
+	ArchiveBenchResult result = {};
+	PackedArchive archive;
+	std::vector<char> extracted;
+
+	for (int pass = 0; pass < 2; ++pass) {
+		LARGE_INTEGER start;
+		QueryPerformanceCounter(&start);
+		if (pass == 0 && !archive.Open(path)) {
+			result.failed = (int)assets.size();
+			return result;
+		}
+
+		UINT32 checksum = 0;
+		for (const auto& asset : assets) {
+			ArchiveView view;
+			if (!archive.Find(asset.name, view)) {
+				++result.failed;
+				continue;
+			}
+			// 원본 항목은 매핑된 메모리를 그대로 사용, 압축 항목만 풀어서 사용
+			if (view.compression == kArchiveStored) {
+				checksum ^= Fnv1a(view.data, view.storedSize);
+			}
+			else if (PackedArchive::Extract(view, extracted)) {
+				checksum ^= Fnv1a(extracted.data(), extracted.size());
+			}
+			else ++result.failed;
+		}
+		(pass == 0 ? result.firstPassMs : result.secondPassMs) = ElapsedMs(start);
+		result.checksum = checksum;
+	}
+	return result;
+}
+
+void PrintArchiveBench(const char* label, const ArchiveBenchResult& result, size_t count)
+{
+	std::cout << label << " : 첫 패스 " << (int)result.firstPassMs << "ms, 두 번째 패스 "
+		<< (int)result.secondPassMs << "ms (에셋당 " << result.secondPassMs * 1000.0 / count
+		<< "us), 검증값 " << std::hex << result.checksum << std::dec;
+	if (result.failed > 0) std::cout << ", 실패 " << result.failed << "개";
+	std::cout << std::endl;
+}
+
+void BenchmarkArchive()
+{
+	const int assetCount = 10000;
+	char tempPath[MAX_PATH];
+	GetTempPathA(MAX_PATH, tempPath);
+	std::string directory = std::string(tempPath) + "mt_archive_assets\\";
+	std::string storedPak = std::string(tempPath) + "mt_assets_stored.pak";
+	std::string rlePak = std::string(tempPath) + "mt_assets_rle.pak";
+
+	// 2~16KB짜리 작은 에셋 10,000개
+	std::vector<LoadRequest> assets;
+	UINT32 seed = 777;
+	CreateDirectoryA(directory.c_str(), NULL);
+	for (int i = 0; i < assetCount; ++i) {
+		LoadRequest request = {};
+		request.name = "asset_" + std::to_string(i);
+		request.path = directory + request.name + ".bin";
+		request.isEssential = (i % 10) == 0;
+		if (!WriteSyntheticAsset(request.path, 2048 + NextRandom(seed) % (14 * 1024), seed)) break;
+		assets.push_back(request);
+	}
+
+	// 같은 에셋으로 "원본 저장" 아카이브와 "RLE" 아카이브를 만듦
+	ArchiveBuilder storedBuilder, rleBuilder;
+	for (const auto& asset : assets) {
+		storedBuilder.AddAssetFile(asset.name, asset.path, false);
+		rleBuilder.AddAssetFile(asset.name, asset.path, true);
+	}
+	storedBuilder.Write(storedPak);
+	rleBuilder.Write(rlePak);
+
+	std::cout << "=== 에셋 " << assets.size() << "개: 개별 파일 vs 아카이브 ===" << std::endl;
+	PrintArchiveBench("개별 파일 (열기+읽기+RLE)", LoadLooseAssets(assets), assets.size());
+	PrintArchiveBench("아카이브 (RLE 풀기)      ", LoadFromArchive(rlePak, assets), assets.size());
+	PrintArchiveBench("아카이브 (원본, 복사 없음)", LoadFromArchive(storedPak, assets), assets.size());
+
+	// 같은 비교를 ResourceLoader 파이프라인으로 (아카이브는 한 번 열어 두고 로더가 공유)
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	int decodeThreads = info.dwNumberOfProcessors < 2 ? 2 : (int)info.dwNumberOfProcessors;
+	std::cout << "--- ResourceLoader (I/O 2 + 디코드 " << decodeThreads << " 스레드, 필수 우선) ---" << std::endl;
+
+	std::vector<LoadRequest> requests = assets;
+	PrintLoadTimings("로더 + 개별 파일          ", LoadWithPools(requests, 2, decodeThreads, true));
+
+	PackedArchive rleArchive, storedArchive;
+	if (rleArchive.Open(rlePak) && storedArchive.Open(storedPak)) {
+		requests = assets;
+		PrintLoadTimings("로더 + 아카이브 (RLE)     ", LoadWithPools(requests, 2, decodeThreads, true, &rleArchive));
+		requests = assets;
+		PrintLoadTimings("로더 + 아카이브 (원본)    ", LoadWithPools(requests, 2, decodeThreads, true, &storedArchive));
+	}
+	else std::cout << "아카이브를 열 수 없습니다." << std::endl;
+	rleArchive.Close();
+	storedArchive.Close();
+
+	DeleteSyntheticAssets(directory, assets);
+	DeleteFileA(storedPak.c_str());
+	DeleteFileA(rlePak.c_str());
+}
+
+// =============================================================================
+// 리소스 캐시: 이름으로 공유, 참조 카운트, 메모리 예산 안에서 CLOCK 교체
+// =============================================================================
+// ResourceData는 isLoaded 플래그뿐이라 같은 리소스를 여러 곳에서 공유하거나
+// 메모리가 부족할 때 내보낼 방법이 없습니다.
+// - 이름 해시로 샤드를 고르고, 샤드마다 SRWLOCK + 해시 맵을 둡니다. 적중은 공유
+//   잠금만 잡으므로 여러 스레드가 동시에 읽어도 서로 막지 않습니다.
+// - 같은 이름을 동시에 요청하면 처음 요청한 스레드만 로딩하고 나머지는 샤드의
+//   조건 변수에서 기다립니다 (로딩 합치기).
+// - ResourceHandle이 살아 있는 동안은 참조 카운트가 남아 교체되지 않습니다.
+// - 교체는 LRU 리스트 대신 CLOCK(참조 비트)을 씁니다. 적중 때 리스트를 옮기려면
+//   배타 잠금이 필요하지만, 참조 비트는 공유 잠금 아래에서 켜기만 하면 됩니다.
+
+enum CacheEntryState : LONG
+{
+	kCacheLoading,
+	kCacheReady,
+	kCacheFailed
+};
+
+struct CacheEntry
+{
+	std::string name;
+	std::vector<char> data;
+	volatile LONG refCount;     // 핸들 수 + 로딩/대기 중인 스레드 수
+	volatile LONG state;
+	volatile LONG referenced;   // CLOCK 참조 비트
+};
+
+// 준비된 항목은 캐시가 소유하므로 참조만 놓음. 0이 된 순간부터는 교체로 지워질 수
+// 있으니 감소 뒤에는 entry를 건드리지 않아야 함
+inline void ReleaseCacheEntry(CacheEntry* entry)
+{
+	InterlockedDecrement(&entry->refCount);
+}
+
+// 실패한 항목은 맵에서 빠지므로 로딩/대기 스레드 중 마지막이 지움
+inline void ReleaseFailedCacheEntry(CacheEntry* entry)
+{
+	if (InterlockedDecrement(&entry->refCount) == 0) delete entry;
+}
+
+class ResourceHandle
+{
+private:
+	CacheEntry* entry;
+
+public:
+	ResourceHandle() : entry(nullptr) {}
+	explicit ResourceHandle(CacheEntry* adopted) : entry(adopted) {}   // 이미 잡은 참조를 넘겨받음
+	ResourceHandle(const ResourceHandle& other) : entry(other.entry)
+	{
+		if (entry) InterlockedIncrement(&entry->refCount);
+	}
+	ResourceHandle(ResourceHandle&& other) : entry(other.entry) { other.entry = nullptr; }
+	ResourceHandle& operator=(ResourceHandle other)
+	{
+		std::swap(entry, other.entry);
+		return *this;
+	}
+	~ResourceHandle() { Reset(); }
+
+	void Reset()
+	{
+		if (entry) ReleaseCacheEntry(entry);
+		entry = nullptr;
+	}
+
+	explicit operator bool() const { return entry != nullptr; }
+	const std::string& Name() const { return entry->name; }
+	const std::vector<char>& Data() const { return entry->data; }
+};
+
+struct CacheStats
+{
+	LONGLONG hits;
+	LONGLONG misses;      // 실제로 로딩한 횟수
+	LONGLONG coalesced;   // 다른 스레드의 로딩을 기다린 횟수
+	LONGLONG evictions;
+	LONGLONG bytes;
+};
+
+class ResourceCache
+{
+public:
+	typedef std::function<bool(const std::string& name, std::vector<char>& out)> LoadFunction;
+	typedef std::function<void(ResourceHandle)> ReadyCallback;
+
+private:
+	struct Shard
+	{
+		SRWLOCK lock;
+		CONDITION_VARIABLE loaded;            // 로딩이 끝나면 기다리던 스레드를 깨움
+		std::unordered_map<std::string, CacheEntry*> entries;
+		std::vector<CacheEntry*> clock;       // 준비된 항목만 (로딩 중인 항목은 교체 대상 아님)
+		size_t hand;
+		size_t bytes;
+		volatile LONGLONG hits;
+		volatile LONGLONG misses;
+		volatile LONGLONG coalesced;
+		volatile LONGLONG evictions;
+		char pad[64];                         // 이웃 샤드와 캐시 라인 공유 방지
+	};
+
+	struct AsyncRequest
+	{
+		ResourceCache* cache;
+		std::string name;
+		ReadyCallback onReady;
+	};
+
+	std::vector<std::unique_ptr<Shard>> shards;
+	size_t shardBudget;      // 샤드마다 예산을 나눠 가짐 (전역 조정 없이 교체)
+	LoadFunction load;
+	// 스레드 풀에 남은 요청 수. 콜백이 감소와 깨우기를 잠금 안에서 끝내므로 소멸자가
+	// 잠금을 다시 얻은 뒤에는 어떤 콜백도 캐시를 건드리지 않음
+	SRWLOCK asyncLock;
+	CONDITION_VARIABLE asyncIdle;
+	LONG pendingAsync;
+
+	Shard& ShardFor(const std::string& name)
+	{
+		return *shards[std::hash<std::string>()(name) % shards.size()];
+	}
+
+	// 배타 잠금 상태에서 호출. 참조 중인 항목은 건너뛰고 참조 비트가 꺼진 항목을 내보냄
+	void EvictLocked(Shard& shard)
+	{
+		size_t scanLimit = shard.clock.size() * 2;
+		for (size_t scanned = 0; shard.bytes > shardBudget && !shard.clock.empty() && scanned < scanLimit; ++scanned) {
+			if (shard.hand >= shard.clock.size()) shard.hand = 0;
+			CacheEntry* entry = shard.clock[shard.hand];
+
+			if (entry->refCount > 0) {
+				++shard.hand;
+				continue;
+			}
+			if (entry->referenced) {
+				entry->referenced = 0;
+				++shard.hand;
+				continue;
+			}
+
+			shard.bytes -= entry->data.size();
+			shard.entries.erase(entry->name);
+			shard.clock[shard.hand] = shard.clock.back();
+			shard.clock.pop_back();
+			++shard.evictions;
+			delete entry;
+		}
+	}
+
+	static VOID CALLBACK AsyncAcquireCallback(PTP_CALLBACK_INSTANCE, PVOID context)
+	{
+		AsyncRequest* request = (AsyncRequest*)context;
+		ResourceCache* cache = request->cache;
+		request->onReady(cache->Acquire(request->name));
+		delete request;
+		cache->FinishAsync();
+	}
+
+	void FinishAsync()
+	{
+		AcquireSRWLockExclusive(&asyncLock);
+		if (--pendingAsync == 0) WakeAllConditionVariable(&asyncIdle);
+		ReleaseSRWLockExclusive(&asyncLock);
+	}
+
+public:
+	ResourceCache(size_t memoryBudget, int shardCount, LoadFunction loadFunction)
+		: shardBudget(memoryBudget / (shardCount < 1 ? 1 : shardCount)), load(loadFunction), pendingAsync(0)
+	{
+		if (shardCount < 1) shardCount = 1;
+		for (int i = 0; i < shardCount; ++i) {
+			Shard* shard = new Shard();
+			InitializeSRWLock(&shard->lock);
+			InitializeConditionVariable(&shard->loaded);
+			shard->hand = 0;
+			shard->bytes = 0;
+			shard->hits = shard->misses = shard->coalesced = shard->evictions = 0;
+			shards.emplace_back(shard);
+		}
+		InitializeSRWLock(&asyncLock);
+		InitializeConditionVariable(&asyncIdle);
+	}
+
+	~ResourceCache()
+	{
+		// 스레드 풀에서 아직 로딩 중인 요청이 끝날 때까지 대기
+		AcquireSRWLockExclusive(&asyncLock);
+		while (pendingAsync != 0) SleepConditionVariableSRW(&asyncIdle, &asyncLock, INFINITE, 0);
+		ReleaseSRWLockExclusive(&asyncLock);
+
+		for (auto& shard : shards) {
+			for (auto& pair : shard->entries) delete pair.second;
+		}
+	}
+
+	// 캐시에 있으면 바로, 없으면 로딩한 뒤 핸들을 돌려줌. 실패하면 빈 핸들
+	ResourceHandle Acquire(const std::string& name)
+	{
+		Shard& shard = ShardFor(name);
+
+		AcquireSRWLockShared(&shard.lock);
+		auto it = shard.entries.find(name);
+		if (it != shard.entries.end() && it->second->state == kCacheReady) {
+			CacheEntry* entry = it->second;
+			InterlockedIncrement(&entry->refCount);
+			entry->referenced = 1;
+			ReleaseSRWLockShared(&shard.lock);
+			InterlockedIncrement64(&shard.hits);
+			return ResourceHandle(entry);
+		}
+		ReleaseSRWLockShared(&shard.lock);
+
+		// 미스이거나 로딩 중: 배타 잠금으로 다시 확인
+		AcquireSRWLockExclusive(&shard.lock);
+		it = shard.entries.find(name);
+		if (it != shard.entries.end()) {
+			CacheEntry* entry = it->second;
+			InterlockedIncrement(&entry->refCount);   // 기다리는 동안 사라지지 않도록
+			bool waited = false;
+			while (entry->state == kCacheLoading) {
+				waited = true;
+				SleepConditionVariableSRW(&shard.loaded, &shard.lock, INFINITE, 0);
+			}
+			bool ready = entry->state == kCacheReady;
+			if (ready) entry->referenced = 1;
+			ReleaseSRWLockExclusive(&shard.lock);
+
+			InterlockedIncrement64(waited ? &shard.coalesced : &shard.hits);
+			if (ready) return ResourceHandle(entry);
+			ReleaseFailedCacheEntry(entry);
+			return ResourceHandle();
+		}
+
+		// 처음 요청한 스레드가 로딩을 맡음 (잠금 밖에서)
+		CacheEntry* entry = new CacheEntry();
+		entry->name = name;
+		entry->refCount = 1;
+		entry->state = kCacheLoading;
+		entry->referenced = 1;
+		shard.entries[name] = entry;
+		ReleaseSRWLockExclusive(&shard.lock);
+		InterlockedIncrement64(&shard.misses);
+
+		bool ok = load(name, entry->data);
+
+		AcquireSRWLockExclusive(&shard.lock);
+		if (ok) {
+			entry->state = kCacheReady;
+			shard.clock.push_back(entry);
+			shard.bytes += entry->data.size();
+			EvictLocked(shard);
+		}
+		else {
+			entry->state = kCacheFailed;
+			shard.entries.erase(name);      // 다음 요청이 다시 시도할 수 있도록
+		}
+		ReleaseSRWLockExclusive(&shard.lock);
+		WakeAllConditionVariable(&shard.loaded);
+
+		if (ok) return ResourceHandle(entry);
+		ReleaseFailedCacheEntry(entry);
+		return ResourceHandle();
+	}
+
+	// 스레드 풀에서 Acquire를 실행하고 준비되면 onReady를 호출 (실패하면 빈 핸들)
+	bool AcquireAsync(const std::string& name, ReadyCallback onReady)
+	{
+		AsyncRequest* request = new AsyncRequest{ this, name, onReady };
+		AcquireSRWLockExclusive(&asyncLock);
+		++pendingAsync;
+		ReleaseSRWLockExclusive(&asyncLock);
+		if (!TrySubmitThreadpoolCallback(AsyncAcquireCallback, request, NULL)) {
+			delete request;
+			FinishAsync();
+			return false;
+		}
+		return true;
+	}
+
+	CacheStats GetStats()
+	{
+		CacheStats stats = {};
+		for (auto& shard : shards) {
+			AcquireSRWLockShared(&shard->lock);
+			stats.bytes += shard->bytes;
+			ReleaseSRWLockShared(&shard->lock);
+			stats.hits += shard->hits;
+			stats.misses += shard->misses;
+			stats.coalesced += shard->coalesced;
+			stats.evictions += shard->evictions;
+		}
+		return stats;
+	}
+};
+
+// ----------------------------------------------------------------------------
+// 16스레드 경합에서 적중/미스 지연 측정
+// ----------------------------------------------------------------------------
+// 캐시 뒤에는 RLE로 압축된 메모리 매핑 아카이브를 두어, 미스 비용에 실제
+// 압축 풀기가 들어가도록 합니다.
+struct CacheBenchParam
+{
+	ResourceCache* cache;
+	const std::vector<std::string>* keys;
+	HANDLE hStart;
+	int threadIndex;
+	int threadCount;
+	int operations;
+	bool disjoint;                 // true면 스레드마다 다른 키만 사용 (전부 미스)
+	std::vector<double> latencyNs; // 일부 연산만 샘플링
+	double elapsedMs;
+};
+
+unsigned __stdcall CacheBenchThread(void* param)
+{
+	CacheBenchParam* p = (CacheBenchParam*)param;
+	LARGE_INTEGER frequency, start, end, t0, t1;
+	QueryPerformanceFrequency(&frequency);
+	UINT32 seed = 1000 + p->threadIndex;
+	size_t keyCount = p->keys->size();
+
+	WaitForSingleObject(p->hStart, INFINITE);
+	QueryPerformanceCounter(&start);
+	for (int i = 0; i < p->operations; ++i) {
+		size_t index = p->disjoint
+			? (p->threadIndex + (size_t)i * p->threadCount) % keyCount
+			: NextRandom(seed) % keyCount;
+		bool sample = p->disjoint || (i & 15) == 0;
+
+		if (sample) QueryPerformanceCounter(&t0);
+		ResourceHandle handle = p->cache->Acquire((*p->keys)[index]);
+		if (sample) {
+			QueryPerformanceCounter(&t1);
+			p->latencyNs.push_back((double)(t1.QuadPart - t0.QuadPart) * 1e9 / frequency.QuadPart);
+		}
+		if (!handle) std::cout << "로딩 실패: " << (*p->keys)[index] << std::endl;
+	}
+	QueryPerformanceCounter(&end);
+	p->elapsedMs = (double)(end.QuadPart - start.QuadPart) * 1000.0 / frequency.QuadPart;
+	return 0;
+}
+
+void RunCacheBench(const char* label, ResourceCache& cache, const std::vector<std::string>& keys,
+	int threadCount, int operations, bool disjoint)
+{
+	HANDLE hStart = CreateEvent(NULL, TRUE, FALSE, NULL);
+	std::vector<CacheBenchParam> params(threadCount);
+	std::vector<HANDLE> threads;
+	for (int i = 0; i < threadCount; ++i) {
+		params[i].cache = &cache;
+		params[i].keys = &keys;
+		params[i].hStart = hStart;
+		params[i].threadIndex = i;
+		params[i].threadCount = threadCount;
+		params[i].operations = operations;
+		params[i].disjoint = disjoint;
+		params[i].elapsedMs = 0;
+		HANDLE hThread = (HANDLE)_beginthreadex(NULL, 0, CacheBenchThread, &params[i], 0, NULL);
+		if (hThread) threads.push_back(hThread);
+	}
+
+	CacheStats before = cache.GetStats();
+	SetEvent(hStart);
+	WaitForAllHandles(threads);
+	CacheStats after = cache.GetStats();
+	for (HANDLE h : threads) CloseHandle(h);
+	CloseHandle(hStart);
+
+	std::vector<double> latencies;
+	double slowestMs = 0;
+	for (const auto& p : params) {
+		latencies.insert(latencies.end(), p.latencyNs.begin(), p.latencyNs.end());
+		if (p.elapsedMs > slowestMs) slowestMs = p.elapsedMs;
+	}
+	std::sort(latencies.begin(), latencies.end());
+	double p50 = latencies.empty() ? 0 : latencies[latencies.size() / 2];
+	double p99 = latencies.empty() ? 0 : latencies[latencies.size() * 99 / 100];
+	double totalOps = (double)threadCount * operations;
+
+	std::cout << label << " : " << (int)(totalOps / slowestMs * 1000.0) << " ops/s, p50 " << (int)p50
+		<< "ns, p99 " << (int)p99 << "ns | 적중 " << (after.hits - before.hits)
+		<< ", 로딩 " << (after.misses - before.misses) << ", 합류 " << (after.coalesced - before.coalesced)
+		<< ", 교체 " << (after.evictions - before.evictions) << ", 사용 " << after.bytes / 1024 << "KB" << std::endl;
+}
+
+void BenchmarkCache()
+{
+	const int assetCount = 4096;
+	const int threadCount = 16;
+	char tempPath[MAX_PATH];
+	GetTempPathA(MAX_PATH, tempPath);
+	std::string pakPath = std::string(tempPath) + "mt_cache_assets.pak";
+
+	// 4~16KB 에셋을 RLE 아카이브로
+	ArchiveBuilder builder;
+	std::vector<std::string> keys;
+	UINT32 seed = 99;
+	size_t totalBytes = 0;
+	std::vector<char> raw;
+	for (int i = 0; i < assetCount; ++i) {
+		raw.resize(4096 + NextRandom(seed) % (12 * 1024));
+		for (size_t j = 0; j < raw.size();) {
+			size_t run = 1 + NextRandom(seed) % 32;
+			if (run > raw.size() - j) run = raw.size() - j;
+			memset(&raw[j], (char)NextRandom(seed), run);
+			j += run;
+		}
+		keys.push_back("asset_" + std::to_string(i));
+		builder.Add(keys.back(), raw.data(), raw.size(), true);
+		totalBytes += raw.size();
+	}
+	builder.Write(pakPath);
+
+	PackedArchive archive;
+	if (!archive.Open(pakPath)) {
+		std::cout << "아카이브를 열 수 없습니다: " << pakPath << std::endl;
+		return;
+	}
+	ResourceCache::LoadFunction loadFromArchive = [&archive](const std::string& name, std::vector<char>& out) {
+		ArchiveView view;
+		return archive.Find(name, view) && PackedArchive::Extract(view, out);
+	};
+
+	std::cout << "=== 리소스 캐시: 에셋 " << assetCount << "개 (" << totalBytes / 1024 << "KB), 스레드 "
+		<< threadCount << "개 ===" << std::endl;
+
+	// 같은 키를 16스레드가 동시에 요청하면 로딩은 한 번
+	{
+		ResourceCache cache(totalBytes, 16, [&loadFromArchive](const std::string& name, std::vector<char>& out) {
+			Sleep(20);   // 느린 저장 장치 흉내
+			return loadFromArchive(name, out);
+		});
+		std::vector<std::string> sameKey(1, keys[0]);
+		RunCacheBench("동시 요청 합치기        ", cache, sameKey, threadCount, 1, false);
+	}
+
+	// 적중: 전부 들어가는 예산에서 미리 채운 뒤 무작위 조회
+	for (int shardCount : { 1, 16 }) {
+		ResourceCache cache(totalBytes * 2, shardCount, loadFromArchive);
+		for (const auto& key : keys) cache.Acquire(key);
+		std::string label = "적중 (샤드 " + std::to_string(shardCount) + "개)" + (shardCount < 10 ? " " : "") + "      ";
+		RunCacheBench(label.c_str(), cache, keys, threadCount, 200000, false);
+	}
+
+	// 미스: 스레드마다 서로 다른 키만 요청, 예산은 전체의 1/4이라 계속 교체
+	{
+		ResourceCache cache(totalBytes / 4, 16, loadFromArchive);
+		RunCacheBench("미스 (예산 25%)         ", cache, keys, threadCount, assetCount / threadCount, true);
+		RunCacheBench("무작위 (예산 25%)       ", cache, keys, threadCount, 50000, false);
+	}
+
+	// 비동기 요청: 스레드 풀에서 로딩한 뒤 콜백 (캐시 소멸자가 남은 요청을 기다림)
+	volatile LONG readyCount = 0;
+	{
+		ResourceCache cache(totalBytes, 16, loadFromArchive);
+		for (int i = 0; i < 256; ++i) {
+			cache.AcquireAsync(keys[i], [&readyCount](ResourceHandle handle) {
+				if (handle) InterlockedIncrement(&readyCount);
+			});
+		}
+	}
+	std::cout << "비동기 요청 256개 중 준비 완료 " << readyCount << "개" << std::endl;
+
+	archive.Close();
+	DeleteFileA(pakPath.c_str());
+}
+
+// =============================================================================
+// 점진적 로딩: 낮은 디테일(LOD)부터 쓸 수 있게 하고 배경에서 단계적으로 올림
+// =============================================================================
+// WaitForMultipleObjects로는 리소스가 "전부" 끝났는지만 알 수 있습니다.
+// LOD 파일은 작은 레벨부터 순서대로 저장하고, 로더는 모든 리소스의 LOD 0을 먼저
+// 읽은 뒤 LOD 1, LOD 2 ... 순으로 올립니다. 소비자는 Subscribe로 "이 리소스가
+// 레벨 N 이상이 되면" 알림을 받고, 읽은 바이트 수는 원자적으로 누적되어
+// GetProgress로 언제든 진행률을 볼 수 있습니다.
+
+const UINT32 kLodMagic = 0x53444F4C; // "LODS"
+const int kMaxLodLevels = 8;
+
+struct LodFileHeader
+{
+	UINT32 magic;
+	UINT32 levelCount;
+	UINT64 levelOffset[kMaxLodLevels];
+	UINT32 levelSize[kMaxLodLevels];
+	UINT32 levelChecksum[kMaxLodLevels];
+};
+
+class ProgressiveResource
+{
+public:
+	typedef std::function<void(ProgressiveResource& resource, int level)> LevelCallback;
+
+private:
+	std::string name;
+	std::string path;
+	bool isEssential;
+	LodFileHeader header;
+	LONGLONG totalBytes;
+
+	volatile LONGLONG bytesLoaded;
+	volatile LONG readyLevel;              // 0..readyLevel까지 사용 가능, -1이면 아직 없음
+	std::vector<std::vector<char>> levels;
+	std::vector<bool> levelLoaded;
+
+	SRWLOCK lock;
+	std::vector<std::pair<int, LevelCallback>> subscribers;
+
+public:
+	ProgressiveResource(const std::string& resourceName, const std::string& filePath, bool essential)
+		: name(resourceName), path(filePath), isEssential(essential), totalBytes(0), bytesLoaded(0), readyLevel(-1)
+	{
+		memset(&header, 0, sizeof(header));
+		InitializeSRWLock(&lock);
+	}
+
+	// 파일 헤더에서 레벨 구성을 읽음
+	bool Open()
+	{
+		HANDLE hFile = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, 0, NULL);
+		if (hFile == INVALID_HANDLE_VALUE) return false;
+		DWORD bytesRead = 0;
+		bool ok = ReadFile(hFile, &header, sizeof(header), &bytesRead, NULL) && bytesRead == sizeof(header) &&
+			header.magic == kLodMagic && header.levelCount >= 1 && header.levelCount <= kMaxLodLevels;
+		CloseHandle(hFile);
+		if (!ok) return false;
+
+		totalBytes = 0;
+		for (UINT32 i = 0; i < header.levelCount; ++i) totalBytes += header.levelSize[i];
+		levels.assign(header.levelCount, std::vector<char>());
+		levelLoaded.assign(header.levelCount, false);
+		return true;
+	}
+
+	// 레벨 level 이상이 준비되면 callback 호출 (이미 준비됐으면 바로 호출)
+	void Subscribe(int level, LevelCallback callback)
+	{
+		AcquireSRWLockExclusive(&lock);
+		if (readyLevel < level) {
+			subscribers.push_back(std::make_pair(level, callback));
+			ReleaseSRWLockExclusive(&lock);
+			return;
+		}
+		int current = readyLevel;
+		ReleaseSRWLockExclusive(&lock);
+		callback(*this, current);
+	}
+
+	// 로더가 읽기 진행 중에 호출
+	void AddBytesLoaded(LONGLONG bytes) { InterlockedExchangeAdd64(&bytesLoaded, bytes); }
+
+	// 로더가 레벨 하나를 다 읽고 검증한 뒤 호출. 낮은 레벨부터 이어진 만큼만 공개
+	void PublishLevel(int level, std::vector<char>&& data)
+	{
+		std::vector<std::pair<int, LevelCallback>> ready;
+
+		AcquireSRWLockExclusive(&lock);
+		levels[level] = std::move(data);
+		levelLoaded[level] = true;
+		int contiguous = readyLevel;
+		while (contiguous + 1 < (int)levelLoaded.size() && levelLoaded[contiguous + 1]) ++contiguous;
+		InterlockedExchange(&readyLevel, contiguous);
+
+		for (size_t i = 0; i < subscribers.size();) {
+			if (subscribers[i].first <= contiguous) {
+				ready.push_back(subscribers[i]);
+				subscribers[i] = subscribers.back();
+				subscribers.pop_back();
+			}
+			else ++i;
+		}
+		ReleaseSRWLockExclusive(&lock);
+
+		// 콜백은 잠금 밖에서 (콜백 안에서 다시 Subscribe해도 되도록)
+		for (auto& subscriber : ready) subscriber.second(*this, contiguous);
+	}
+
+	const std::string& GetName() const { return name; }
+	const std::string& GetPath() const { return path; }
+	bool IsEssential() const { return isEssential; }
+	int GetLevelCount() const { return (int)header.levelCount; }
+	int GetReadyLevel() const { return readyLevel; }
+	const LodFileHeader& GetHeader() const { return header; }
+	LONGLONG GetTotalBytes() const { return totalBytes; }
+	LONGLONG GetBytesLoaded() const { return bytesLoaded; }
+	double GetProgress() const { return totalBytes > 0 ? (double)bytesLoaded / totalBytes : 1.0; }
+
+	// level <= GetReadyLevel()인 레벨만 읽어야 함
+	const std::vector<char>& GetLevelData(int level) const { return levels[level]; }
+};
+
+// 레벨 단위 작업을 여러 스레드가 나눠 읽는 로더
+// 저장 장치 대역폭은 bytesPerMs로 흉내 냄 (모든 스트림이 한 장치를 나눠 씀)
+class ProgressiveLoader
+{
+private:
+	struct StreamItem
+	{
+		ProgressiveResource* resource;
+		int level;
+	};
+
+	static const DWORD kReadChunk = 64 * 1024;
+
+	std::vector<StreamItem> items;
+	volatile LONG nextItem;
+	std::vector<HANDLE> threads;
+
+	CRITICAL_SECTION deviceLock;
+	double bytesPerMs;
+	double deviceFreeAtMs;     // 흉내 낸 장치가 다음 요청을 받을 수 있는 시각
+	LARGE_INTEGER frequency;
+	LARGE_INTEGER startTick;
+
+	double NowMs() const
+	{
+		LARGE_INTEGER now;
+		QueryPerformanceCounter(&now);
+		return (double)(now.QuadPart - startTick.QuadPart) * 1000.0 / frequency.QuadPart;
+	}
+
+	// 장치를 bytes만큼 쓰는 시간을 예약하고 그때까지 대기
+	void ThrottleDevice(DWORD bytes)
+	{
+		if (bytesPerMs <= 0) return;
+		EnterCriticalSection(&deviceLock);
+		double now = NowMs();
+		if (deviceFreeAtMs < now) deviceFreeAtMs = now;
+		deviceFreeAtMs += bytes / bytesPerMs;
+		double doneAt = deviceFreeAtMs;
+		LeaveCriticalSection(&deviceLock);
+
+		double wait = doneAt - NowMs();
+		if (wait >= 1.0) Sleep((DWORD)wait);
+	}
+
+	bool StreamLevel(ProgressiveResource& resource, int level)
+	{
+		const LodFileHeader& header = resource.GetHeader();
+		HANDLE hFile = CreateFileA(resource.GetPath().c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, 0, NULL);
+		if (hFile == INVALID_HANDLE_VALUE) return false;
+
+		LARGE_INTEGER offset;
+		offset.QuadPart = (LONGLONG)header.levelOffset[level];
+		std::vector<char> data(header.levelSize[level]);
+		bool ok = SetFilePointerEx(hFile, offset, NULL, FILE_BEGIN) != FALSE;
+		for (size_t done = 0; ok && done < data.size();) {
+			DWORD request = (DWORD)(data.size() - done < kReadChunk ? data.size() - done : kReadChunk);
+			DWORD bytesRead = 0;
+			ok = ReadFile(hFile, &data[done], request, &bytesRead, NULL) && bytesRead > 0;
+			ThrottleDevice(bytesRead);
+			resource.AddBytesLoaded(bytesRead);
+			done += bytesRead;
+		}
+		CloseHandle(hFile);
+
+		if (!ok || Fnv1a(data.data(), data.size()) != header.levelChecksum[level]) return false;
+		resource.PublishLevel(level, std::move(data));
+		return true;
+	}
+
+	static unsigned __stdcall StreamThread(void* param)
+	{
+		ProgressiveLoader* loader = (ProgressiveLoader*)param;
+		for (;;) {
+			LONG index = InterlockedIncrement(&loader->nextItem) - 1;
+			if (index >= (LONG)loader->items.size()) break;
+			const StreamItem& item = loader->items[index];
+			if (!loader->StreamLevel(*item.resource, item.level)) {
+				std::cout << "[LOD 로딩 실패] " << item.resource->GetName() << " LOD " << item.level << std::endl;
+			}
+		}
+		return 0;
+	}
+
+public:
+	explicit ProgressiveLoader(double megabytesPerSecond)
+		: nextItem(0), bytesPerMs(megabytesPerSecond * 1024.0 * 1024.0 / 1000.0), deviceFreeAtMs(0)
+	{
+		InitializeCriticalSection(&deviceLock);
+		QueryPerformanceFrequency(&frequency);
+		QueryPerformanceCounter(&startTick);
+	}
+
+	~ProgressiveLoader()
+	{
+		Wait();
+		DeleteCriticalSection(&deviceLock);
+	}
+
+	// progressive가 true면 모든 리소스의 낮은 레벨부터, false면 리소스 하나씩 끝까지
+	// 어느 쪽이든 같은 레벨 안에서는 필수 리소스가 먼저
+	void Start(const std::vector<ProgressiveResource*>& resources, bool progressive, int threadCount)
+	{
+		items.clear();
+		for (auto* resource : resources) {
+			for (int level = 0; level < resource->GetLevelCount(); ++level) {
+				items.push_back({ resource, level });
+			}
+		}
+		std::stable_sort(items.begin(), items.end(), [progressive](const StreamItem& a, const StreamItem& b) {
+			if (progressive && a.level != b.level) return a.level < b.level;
+			return a.resource->IsEssential() && !b.resource->IsEssential();
+		});
+
+		nextItem = 0;
+		QueryPerformanceCounter(&startTick);
+		deviceFreeAtMs = 0;
+		if (threadCount > MAXIMUM_WAIT_OBJECTS) threadCount = MAXIMUM_WAIT_OBJECTS;
+		for (int i = 0; i < threadCount; ++i) {
+			HANDLE hThread = (HANDLE)_beginthreadex(NULL, 0, StreamThread, this, 0, NULL);
+			if (hThread) threads.push_back(hThread);
+		}
+	}
+
+	// 모든 스트림이 끝나면 true, 시간 안에 끝나지 않으면 false
+	bool Wait(DWORD timeoutMs = INFINITE)
+	{
+		if (threads.empty()) return true;
+		if (WaitForMultipleObjects((DWORD)threads.size(), threads.data(), TRUE, timeoutMs) == WAIT_TIMEOUT) return false;
+		for (HANDLE h : threads) CloseHandle(h);
+		threads.clear();
+		return true;
+	}
+};
+
+// ----------------------------------------------------------------------------
+// 점진적 로딩으로 게임을 얼마나 일찍 시작할 수 있는지 측정
+// ----------------------------------------------------------------------------
+bool WriteLodAsset(const std::string& path, int levelCount, UINT32 baseSize, UINT32& seed)
+{
+	LodFileHeader header = {};
+	header.magic = kLodMagic;
+	header.levelCount = levelCount;
+
+	std::vector<std::vector<char>> levels(levelCount);
+	UINT64 offset = sizeof(header);
+	for (int level = 0; level < levelCount; ++level) {
+		levels[level].resize((size_t)baseSize << (2 * level));   // 레벨마다 4배 (밉맵처럼)
+		for (char& c : levels[level]) c = (char)NextRandom(seed);
+		header.levelOffset[level] = offset;
+		header.levelSize[level] = (UINT32)levels[level].size();
+		header.levelChecksum[level] = Fnv1a(levels[level].data(), levels[level].size());
+		offset += levels[level].size();
+	}
+
+	HANDLE hFile = CreateFileA(path.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (hFile == INVALID_HANDLE_VALUE) return false;
+	DWORD written = 0;
+	bool ok = WriteFile(hFile, &header, sizeof(header), &written, NULL) != FALSE;
+	for (int level = 0; ok && level < levelCount; ++level) {
+		ok = WriteFile(hFile, levels[level].data(), (DWORD)levels[level].size(), &written, NULL) != FALSE;
+	}
+	CloseHandle(hFile);
+	return ok;
+}
+
+struct ProgressiveRunResult
+{
+	double playableMs[kMaxLodLevels];   // 필수 리소스가 모두 레벨 N 이상이 된 시각 (도달하지 못했으면 음수)
+	double allLoadedMs;
+};
+
+// 검증에 실패한 레벨은 구독이 불리지 않으므로 시각이 남지 않음
+void PrintPlayableMs(double ms)
+{
+	if (ms < 0) std::cout << "미도달";
+	else std::cout << (int)ms << "ms";
+}
+
+ProgressiveRunResult RunProgressiveLoad(const std::vector<std::string>& paths, const std::vector<bool>& essential,
+	int levelCount, bool progressive, bool printProgress)
+{
+	const double deviceMBps = 100.0;
+	const int streamThreads = 4;
+
+	std::vector<std::unique_ptr<ProgressiveResource>> resources;
+	std::vector<ProgressiveResource*> pointers;
+	for (size_t i = 0; i < paths.size(); ++i) {
+		resources.emplace_back(new ProgressiveResource("lod_" + std::to_string(i), paths[i], essential[i]));
+		if (resources.back()->Open()) pointers.push_back(resources.back().get());
+	}
+
+	// 레벨마다 "필수 리소스가 전부 이 레벨 이상"이 된 시각을 구독으로 기록
+	LARGE_INTEGER start;
+	QueryPerformanceCounter(&start);
+	ProgressiveRunResult result = {};
+	std::vector<LONG> remaining(levelCount, 0);
+	for (int level = 0; level < levelCount; ++level) {
+		for (auto* resource : pointers) {
+			if (resource->IsEssential()) ++remaining[level];
+		}
+		result.playableMs[level] = remaining[level] == 0 ? 0.0 : -1.0;
+	}
+	for (auto* resource : pointers) {
+		if (!resource->IsEssential()) continue;
+		for (int level = 0; level < levelCount; ++level) {
+			resource->Subscribe(level, [&remaining, &result, &start, level](ProgressiveResource&, int) {
+				if (InterlockedDecrement(&remaining[level]) == 0) result.playableMs[level] = ElapsedMs(start);
+			});
+		}
+	}
+
+	ProgressiveLoader loader(deviceMBps);
+	loader.Start(pointers, progressive, streamThreads);
+
+	// 원자적 카운터로 전체 진행률을 주기적으로 확인
+	LONGLONG total = 0;
+	for (auto* resource : pointers) total += resource->GetTotalBytes();
+	while (!loader.Wait(printProgress ? 100 : INFINITE)) {
+		LONGLONG loaded = 0;
+		int essentialLevel = levelCount - 1;
+		for (auto* resource : pointers) {
+			loaded += resource->GetBytesLoaded();
+			if (resource->IsEssential() && resource->GetReadyLevel() < essentialLevel) essentialLevel = resource->GetReadyLevel();
+		}
+		std::cout << "  진행률 " << (int)(loaded * 100 / (total > 0 ? total : 1)) << "% (필수 리소스 LOD "
+			<< essentialLevel << "까지 준비)" << std::endl;
+	}
+	result.allLoadedMs = ElapsedMs(start);
+	return result;
+}
+
+void BenchmarkProgressive()
+{
+	const int resourceCount = 40;
+	const int levelCount = 4;
+	const UINT32 baseSize = 16 * 1024;   // LOD 0 = 16KB, LOD 3 = 1MB
+	char tempPath[MAX_PATH];
+	GetTempPathA(MAX_PATH, tempPath);
+	std::string prefix = std::string(tempPath) + "mt_lod_";
+
+	std::vector<std::string> paths;
+	std::vector<bool> essential;
+	UINT32 seed = 4242;
+	for (int i = 0; i < resourceCount; ++i) {
+		paths.push_back(prefix + std::to_string(i) + ".lod");
+		essential.push_back(i % 5 == 0);    // 8개가 필수
+		if (!WriteLodAsset(paths.back(), levelCount, baseSize, seed)) {
+			std::cout << "LOD 에셋 생성 실패: " << paths.back() << std::endl;
+			return;
+		}
+	}
+
+	std::cout << "=== 점진적 로딩: 리소스 " << resourceCount << "개 (필수 8개), LOD " << levelCount
+		<< "단계, 100MB/s 장치 ===" << std::endl;
+
+	ProgressiveRunResult full = RunProgressiveLoad(paths, essential, levelCount, false, false);
+	std::cout << "리소스 단위 로딩 : 필수 리소스 완전 로딩 ";
+	PrintPlayableMs(full.playableMs[levelCount - 1]);
+	std::cout << ", 전체 " << (int)full.allLoadedMs << "ms" << std::endl;
+
+	ProgressiveRunResult progressive = RunProgressiveLoad(paths, essential, levelCount, true, true);
+	std::cout << "점진적 로딩     :";
+	for (int level = 0; level < levelCount; ++level) {
+		std::cout << " LOD" << level << " ";
+		PrintPlayableMs(progressive.playableMs[level]);
+	}
+	std::cout << ", 전체 " << (int)progressive.allLoadedMs << "ms" << std::endl;
+	if (full.playableMs[levelCount - 1] >= 0 && progressive.playableMs[0] >= 0) {
+		std::cout << "LOD 0으로 시작하면 " << (int)(full.playableMs[levelCount - 1] - progressive.playableMs[0])
+			<< "ms 일찍 게임을 시작할 수 있습니다." << std::endl;
+	}
+
+	for (const auto& path : paths) DeleteFileA(path.c_str());
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc > 1 && strcmp(argv[1], "--bench-loader") == 0) {
+		BenchmarkLoader();
+		return 0;
+	}
+	if (argc > 1 && strcmp(argv[1], "--bench-archive") == 0) {
+		BenchmarkArchive();
+		return 0;
+	}
+	if (argc > 1 && strcmp(argv[1], "--bench-cache") == 0) {
+		BenchmarkCache();
+		return 0;
+	}
+	if (argc > 1 && strcmp(argv[1], "--bench-progressive") == 0) {
+		BenchmarkProgressive();
+		return 0;
+	}
+	if (argc > 3 && strcmp(argv[1], "--pack") == 0) {
+		return PackArchiveCommand(argc, argv);
+	}
+	if (argc > 2 && strcmp(argv[1], "--list") == 0) {
+		return ListArchiveCommand(argv[2]);
+	}
+
 	// 리소스 데이터 설정
 	ResourceData resources[4] = {
 		{"기본 텍스처", true, 2},    // 필수
@@ -4,13 +4,381 @@
 #include <string>
 #include <cstdlib>
 #include <ctime>
+#include <cstring>
+#include <vector>
+#include <deque>
+#include <queue>
+#include <functional>
+#include <algorithm>
+
+// ------------------------------------------------------------
+// 턴 수집 서비스
+// 플레이어마다 스레드를 두고 WaitForMultipleObjects로 기다리면 전투 수천 개에서
+// 스레드가 수만 개 필요하고, 시간 초과 뒤 다른 스레드가 쓰던 필드를 동기화 없이
+// 읽게 됩니다. TurnCollector는 전투마다 턴 슬롯 배열을 두고 행동 제출을 CAS 한 번으로
+// 기록하며, 마감 시각은 타이머 스레드 하나가 모든 전투를 관리합니다.
+// 모두 제출하면 제출한 쪽이 바로 마감하고, 턴 처리는 작은 작업자 풀이 맡습니다.
+// ------------------------------------------------------------
+
+enum TurnAction : LONG {
+	kActionNone = 0,
+	kActionAttack,
+	kActionDefend,
+	kActionSkill,
+	kActionItem,
+	kActionFlee,
+	kActionDefaultAttack    // 제한 시간 안에 고르지 않은 플레이어
+};
+
+const char* const kActionNames[] = { "(없음)", "공격", "방어", "스킬", "아이템", "도망", "기본 공격" };
+
+const int kMaxPlayersPerBattle = 8;
+
+// 슬롯 값: 상위 비트 = 턴 번호, 비트 4 = 봉인(처리 시작됨), 하위 4비트 = 행동
+inline LONGLONG MakeSlot(LONG turn, LONG action, bool sealed)
+{
+	return ((LONGLONG)turn << 8) | (sealed ? 0x10 : 0) | action;
+}
+
+// 전투 상태: 상위 32비트 = 턴 번호, 비트 31 = 마감됨, 하위 31비트 = 남은 제출 수
+inline LONGLONG MakeTurnState(LONG turn, LONG remaining, bool closed)
+{
+	return ((LONGLONG)turn << 32) | (closed ? 0x80000000LL : 0) | (LONGLONG)remaining;
+}
+inline LONG StateTurn(LONGLONG state) { return (LONG)(state >> 32); }
+inline bool StateClosed(LONGLONG state) { return (state & 0x80000000LL) != 0; }
+inline LONG StateRemaining(LONGLONG state) { return (LONG)(state & 0x7FFFFFFF); }
+
+enum SubmitResult {
+	kSubmitAccepted,
+	kSubmitDuplicate,   // 이번 턴에 이미 제출함
+	kSubmitLate         // 턴이 이미 마감됨 (또는 잘못된 턴/플레이어)
+};
+
+struct TurnResult {
+	int battleId;
+	LONG turn;
+	int playerCount;
+	LONG actions[kMaxPlayersPerBattle];
+	int submittedCount;
+	bool closedByDeadline;
+	LONGLONG closeQpc;      // 마지막 제출 시각 또는 마감 시각
+	LONGLONG resolvedQpc;
+};
+
+class TurnCollector {
+public:
+	// false를 반환하면 그 전투는 다음 턴을 열지 않고 끝남
+	typedef std::function<bool(const TurnResult&)> ResolveCallback;
+
+private:
+	struct Battle {
+		volatile LONGLONG state;
+		volatile LONGLONG slots[kMaxPlayersPerBattle];
+	};
+
+	struct Deadline {
+		LONGLONG qpc;
+		int battleId;
+		LONG turn;
+		bool operator>(const Deadline& other) const { return qpc > other.qpc; }
+	};
+
+	struct ResolveJob {
+		int battleId;
+		LONG turn;
+		LONGLONG closeQpc;
+		bool byDeadline;
+	};
+
+	int playersPerBattle;
+	LONGLONG timeoutQpc;
+	LONGLONG frequency;
+	ResolveCallback onResolved;
+	std::vector<Battle> battles;
+
+	// 공유 마감 타이머: 전투 전체의 마감 시각을 힙 하나로 관리
+	SRWLOCK timerLock;
+	CONDITION_VARIABLE timerWake;
+	std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>> deadlines;
+	HANDLE timerThread;
+
+	// 마감된 턴을 처리하는 작업자 풀
+	SRWLOCK jobLock;
+	CONDITION_VARIABLE jobReady;
+	std::deque<ResolveJob> jobs;
+	std::vector<HANDLE> workers;
+	int workerCount;
+
+	volatile LONG stopping;
+
+	// 작업자별 지연 기록 (마감 시점 ~ 처리 완료, 마이크로초)
+	std::vector<std::vector<double>> earlyLatencyUs;
+	std::vector<std::vector<double>> deadlineLatencyUs;
+	volatile LONG nextWorkerIndex;
+
+	static LONGLONG Now()
+	{
+		LARGE_INTEGER now;
+		QueryPerformanceCounter(&now);
+		return now.QuadPart;
+	}
+
+	void OpenTurn(int battleId, LONG turn)
+	{
+		Battle& battle = battles[battleId];
+		// 슬롯을 먼저 비운 뒤 상태를 공개하므로, 새 턴 번호를 본 제출자는 항상 빈 슬롯을 봄
+		for (int i = 0; i < playersPerBattle; ++i) {
+			InterlockedExchange64(&battle.slots[i], MakeSlot(turn, kActionNone, false));
+		}
+		// 상태는 마감을 넣기 전에 공개. 마감이 먼저 들어가면 타이머의 TryClose가 아직
+		// 이전 턴 번호를 보고 실패해 이 턴이 영영 닫히지 않을 수 있음
+		InterlockedExchange64(&battle.state, MakeTurnState(turn, playersPerBattle, false));
+
+		Deadline deadline = { Now() + timeoutQpc, battleId, turn };
+		AcquireSRWLockExclusive(&timerLock);
+		bool earliest = deadlines.empty() || deadline.qpc < deadlines.top().qpc;
+		deadlines.push(deadline);
+		ReleaseSRWLockExclusive(&timerLock);
+		// 제한 시간이 모두 같으면 새 마감이 맨 앞이 되는 일은 드물어 타이머를 거의 깨우지 않음
+		if (earliest) WakeConditionVariable(&timerWake);
+	}
+
+	// 마감 비트를 세운 쪽이 처리 작업을 하나만 넣음
+	bool TryClose(int battleId, LONG turn, bool byDeadline, LONGLONG closeQpc)
+	{
+		Battle& battle = battles[battleId];
+		for (;;) {
+			LONGLONG state = battle.state;
+			if (StateTurn(state) != turn || StateClosed(state)) return false;
+			LONGLONG closed = MakeTurnState(turn, StateRemaining(state), true);
+			if (InterlockedCompareExchange64(&battle.state, closed, state) == state) break;
+		}
+		EnqueueResolve(battleId, turn, closeQpc, byDeadline);
+		return true;
+	}
+
+	void EnqueueResolve(int battleId, LONG turn, LONGLONG closeQpc, bool byDeadline)
+	{
+		ResolveJob job = { battleId, turn, closeQpc, byDeadline };
+		AcquireSRWLockExclusive(&jobLock);
+		jobs.push_back(job);
+		ReleaseSRWLockExclusive(&jobLock);
+		WakeConditionVariable(&jobReady);
+	}
+
+	void Resolve(const ResolveJob& job, int workerIndex)
+	{
+		Battle& battle = battles[job.battleId];
+		TurnResult result;
+		result.battleId = job.battleId;
+		result.turn = job.turn;
+		result.playerCount = playersPerBattle;
+		result.submittedCount = 0;
+		result.closedByDeadline = job.byDeadline;
+		result.closeQpc = job.closeQpc;
+
+		// 슬롯을 봉인하면서 값을 읽음. 봉인 뒤의 제출은 CAS가 실패해 늦은 제출로 처리됨
+		for (int i = 0; i < playersPerBattle; ++i) {
+			LONGLONG value = InterlockedExchange64(&battle.slots[i], MakeSlot(job.turn, kActionNone, true));
+			LONG action = (LONG)(value & 0x0F);
+			if (value == MakeSlot(job.turn, action, false) && action != kActionNone) {
+				result.actions[i] = action;
+				++result.submittedCount;
+			}
+			else {
+				result.actions[i] = kActionDefaultAttack;
+			}
+		}
+
+		bool keepGoing = onResolved ? onResolved(result) : true;
+		result.resolvedQpc = Now();
+
+		double latencyUs = (double)(result.resolvedQpc - job.closeQpc) * 1000000.0 / frequency;
+		(job.byDeadline ? deadlineLatencyUs : earlyLatencyUs)[workerIndex].push_back(latencyUs);
+
+		if (keepGoing && !stopping) OpenTurn(job.battleId, job.turn + 1);
+	}
+
+	static unsigned __stdcall TimerThread(void* param)
+	{
+		TurnCollector* self = (TurnCollector*)param;
+		std::vector<Deadline> expired;
+
+		AcquireSRWLockExclusive(&self->timerLock);
+		while (!self->stopping) {
+			DWORD waitMs = INFINITE;
+			if (!self->deadlines.empty()) {
+				LONGLONG remaining = self->deadlines.top().qpc - Now();
+				if (remaining > 0) waitMs = (DWORD)(remaining * 1000 / self->frequency) + 1;
+				else waitMs = 0;
+			}
+			if (waitMs != 0) {
+				SleepConditionVariableSRW(&self->timerWake, &self->timerLock, waitMs, 0);
+				continue;
+			}
+
+			LONGLONG now = Now();
+			while (!self->deadlines.empty() && self->deadlines.top().qpc <= now) {
+				expired.push_back(self->deadlines.top());
+				self->deadlines.pop();
+			}
+			ReleaseSRWLockExclusive(&self->timerLock);
+
+			// 이미 모두 제출해 마감된 턴은 TryClose에서 바로 걸러짐
+			for (const Deadline& deadline : expired) {
+				self->TryClose(deadline.battleId, deadline.turn, true, deadline.qpc);
+			}
+			expired.clear();
+
+			AcquireSRWLockExclusive(&self->timerLock);
+		}
+		ReleaseSRWLockExclusive(&self->timerLock);
+		return 0;
+	}
+
+	static unsigned __stdcall WorkerThread(void* param)
+	{
+		TurnCollector* self = (TurnCollector*)param;
+		int workerIndex = (int)InterlockedIncrement(&self->nextWorkerIndex) - 1;
+
+		for (;;) {
+			AcquireSRWLockExclusive(&self->jobLock);
+			while (self->jobs.empty() && !self->stopping) {
+				SleepConditionVariableSRW(&self->jobReady, &self->jobLock, INFINITE, 0);
+			}
+			if (self->stopping) {
+				ReleaseSRWLockExclusive(&self->jobLock);
+				break;
+			}
+			ResolveJob job = self->jobs.front();
+			self->jobs.pop_front();
+			ReleaseSRWLockExclusive(&self->jobLock);
+
+			self->Resolve(job, workerIndex);
+		}
+		return 0;
+	}
+
+public:
+	TurnCollector(int battleCount, int playersPerBattle, DWORD turnTimeoutMs, int workerCount, ResolveCallback onResolved)
+		: playersPerBattle(playersPerBattle > kMaxPlayersPerBattle ? kMaxPlayersPerBattle : playersPerBattle),
+		onResolved(onResolved), battles(battleCount), timerThread(nullptr),
+		workerCount(workerCount < 1 ? 1 : workerCount), stopping(0),
+		earlyLatencyUs(workerCount < 1 ? 1 : workerCount), deadlineLatencyUs(workerCount < 1 ? 1 : workerCount),
+		nextWorkerIndex(0)
+	{
+		LARGE_INTEGER qpcFrequency;
+		QueryPerformanceFrequency(&qpcFrequency);
+		frequency = qpcFrequency.QuadPart;
+		timeoutQpc = frequency * turnTimeoutMs / 1000;
+
+		InitializeSRWLock(&timerLock);
+		InitializeConditionVariable(&timerWake);
+		InitializeSRWLock(&jobLock);
+		InitializeConditionVariable(&jobReady);
+		for (Battle& battle : battles) {
+			battle.state = MakeTurnState(0, 0, true);
+			for (int i = 0; i < kMaxPlayersPerBattle; ++i) battle.slots[i] = MakeSlot(0, kActionNone, true);
+		}
+	}
+
+	~TurnCollector() { Stop(); }
+
+	// 모든 전투의 1턴을 열고 타이머와 작업자를 시작
+	bool Start()
+	{
+		for (int i = 0; i < (int)battles.size(); ++i) OpenTurn(i, 1);
+
+		timerThread = (HANDLE)_beginthreadex(nullptr, 0, TimerThread, this, 0, nullptr);
+		if (timerThread == nullptr) return false;
+		for (int i = 0; i < workerCount; ++i) {
+			HANDLE worker = (HANDLE)_beginthreadex(nullptr, 0, WorkerThread, this, 0, nullptr);
+			if (worker == nullptr) return false;
+			workers.push_back(worker);
+		}
+		return true;
+	}
+
+	// 처리 대기 중인 턴은 버리고 스레드를 모두 종료
+	void Stop()
+	{
+		if (timerThread == nullptr && workers.empty()) return;
+		InterlockedExchange(&stopping, 1);
+
+		AcquireSRWLockExclusive(&timerLock);
+		ReleaseSRWLockExclusive(&timerLock);
+		WakeAllConditionVariable(&timerWake);
+		AcquireSRWLockExclusive(&jobLock);
+		ReleaseSRWLockExclusive(&jobLock);
+		WakeAllConditionVariable(&jobReady);
+
+		if (timerThread) {
+			WaitForSingleObject(timerThread, INFINITE);
+			CloseHandle(timerThread);
+			timerThread = nullptr;
+		}
+		for (HANDLE worker : workers) {
+			WaitForSingleObject(worker, INFINITE);
+			CloseHandle(worker);
+		}
+		workers.clear();
+	}
+
+	// 현재 열려 있는 턴 번호. 마감되어 처리 중이거나 끝난 전투는 0
+	LONG GetOpenTurn(int battleId) const
+	{
+		LONGLONG state = battles[battleId].state;
+		return StateClosed(state) ? 0 : StateTurn(state);
+	}
+
+	// 잠금 없이 행동을 제출. 마지막 제출자가 턴을 바로 마감함
+	SubmitResult Submit(int battleId, LONG turn, int player, TurnAction action)
+	{
+		if (battleId < 0 || battleId >= (int)battles.size() || player < 0 || player >= playersPerBattle) return kSubmitLate;
+		if (action == kActionNone || action == kActionDefaultAttack) return kSubmitLate;
+		Battle& battle = battles[battleId];
+
+		LONGLONG state = battle.state;
+		if (StateTurn(state) != turn || StateClosed(state)) return kSubmitLate;
+
+		LONGLONG empty = MakeSlot(turn, kActionNone, false);
+		LONGLONG previous = InterlockedCompareExchange64(&battle.slots[player], MakeSlot(turn, action, false), empty);
+		if (previous != empty) {
+			bool sameTurnOpen = (previous >> 8) == turn && (previous & 0x10) == 0;
+			return sameTurnOpen ? kSubmitDuplicate : kSubmitLate;
+		}
+
+		// 슬롯 기록이 봉인보다 먼저 일어났으므로 행동은 반영됨. 남은 수만 줄이면 됨
+		for (;;) {
+			state = battle.state;
+			if (StateTurn(state) != turn || StateClosed(state)) return kSubmitAccepted;
+			LONG remaining = StateRemaining(state) - 1;
+			LONGLONG next = MakeTurnState(turn, remaining, remaining == 0);
+			if (InterlockedCompareExchange64(&battle.state, next, state) == state) {
+				if (remaining == 0) EnqueueResolve(battleId, turn, Now(), false);
+				return kSubmitAccepted;
+			}
+		}
+	}
+
+	// Stop 이후에 호출. 조기 마감/시간 초과 마감별 처리 지연 (마이크로초)
+	void CollectLatencies(std::vector<double>& early, std::vector<double>& byDeadline) const
+	{
+		early.clear();
+		byDeadline.clear();
+		for (const auto& values : earlyLatencyUs) early.insert(early.end(), values.begin(), values.end());
+		for (const auto& values : deadlineLatencyUs) byDeadline.insert(byDeadline.end(), values.begin(), values.end());
+	}
+};
 
 struct PlayerAction {
 	int playerId;
 	std::string playerName;
 	std::string action;
-	bool hasSelected;
 	int thinkingTime; // 사고 시간 (초)
+	TurnCollector* collector;
+	LONG turn;
 };
 
 unsigned __stdcall PlayerThinkingThread(void* param)
@@ -22,25 +390,179 @@ unsigned __stdcall PlayerThinkingThread(void* param)
 	// 랜덤한 사고 시간 (1-5초)
 	Sleep(player->thinkingTime * 1000);
 
-	// 랜덤 액션 선택
-	std::string actions[] = { "공격", "방어", "스킬", "아이템", "도망" };
-	player->action = actions[rand() % 5];
-	player->hasSelected = true;
+	// 랜덤 액션 선택 후 턴 슬롯에 제출 (결과는 턴 처리 콜백에서 받음)
+	TurnAction action = (TurnAction)(kActionAttack + rand() % 5);
+	SubmitResult result = player->collector->Submit(0, player->turn, player->playerId - 1, action);
+
+	if (result == kSubmitAccepted) {
+		std::cout << "[선택 완료] " << player->playerName << " -> " << kActionNames[action] << std::endl;
+	}
+	else {
+		std::cout << "[시간 초과] " << player->playerName << "의 선택이 반영되지 않았습니다." << std::endl;
+	}
+	return 0;
+}
+
+// ------------------------------------------------------------
+// 벤치마크: 동시 전투 수천~1만 개의 턴 처리 지연
+// ------------------------------------------------------------
+
+double Percentile(std::vector<double> values, double ratio)
+{
+	if (values.empty()) return 0.0;
+	std::sort(values.begin(), values.end());
+	size_t index = (size_t)(ratio * (values.size() - 1) + 0.5);
+	return values[index];
+}
+
+// 전투/턴/플레이어마다 정해지는 가짜 사고 시간. 0이면 잠수 (제출하지 않음)
+inline DWORD SimulatedThinkMs(int battleId, LONG turn, int player)
+{
+	UINT32 hash = (UINT32)battleId * 2654435761u ^ (UINT32)turn * 40503u ^ (UINT32)player * 9973u;
+	hash ^= hash >> 13;
+	hash *= 0x5bd1e995u;
+	hash ^= hash >> 15;
+	if (hash % 100 < 5) return 0;
+	return 1 + hash % 180;
+}
+
+struct BotParam {
+	TurnCollector* collector;
+	int firstBattle;
+	int lastBattle;
+	int playersPerBattle;
+	volatile bool* stop;
+	LONGLONG submitted;
+	LONGLONG rejected;
+};
+
+// 봇 스레드 하나가 전투 여러 개의 플레이어를 흉내 냄 (플레이어마다 스레드를 두지 않음)
+unsigned __stdcall BotThread(void* param)
+{
+	BotParam* bot = (BotParam*)param;
+	int battleCount = bot->lastBattle - bot->firstBattle;
+	std::vector<LONG> seenTurn(battleCount, 0);
+	std::vector<DWORD> seenAt(battleCount, 0);
+	std::vector<unsigned char> pending(battleCount, 0);   // 아직 제출하지 않은 플레이어 비트
 
-	std::cout << "[선택 완료] " << player->playerName << " -> " << player->action << std::endl;
+	while (!*bot->stop) {
+		DWORD now = GetTickCount();
+		for (int i = 0; i < battleCount; ++i) {
+			int battleId = bot->firstBattle + i;
+			LONG turn = bot->collector->GetOpenTurn(battleId);
+			if (turn == 0) continue;
+			if (turn != seenTurn[i]) {
+				seenTurn[i] = turn;
+				seenAt[i] = now;
+				pending[i] = (unsigned char)((1 << bot->playersPerBattle) - 1);
+			}
+			for (int player = 0; player < bot->playersPerBattle && pending[i]; ++player) {
+				if ((pending[i] & (1 << player)) == 0) continue;
+				DWORD thinkMs = SimulatedThinkMs(battleId, turn, player);
+				if (thinkMs == 0 || now - seenAt[i] < thinkMs) continue;
+				pending[i] &= (unsigned char)~(1 << player);
+				TurnAction action = (TurnAction)(kActionAttack + (thinkMs % 5));
+				if (bot->collector->Submit(battleId, turn, player, action) == kSubmitAccepted) ++bot->submitted;
+				else ++bot->rejected;
+			}
+		}
+		Sleep(1);
+	}
 	return 0;
 }
 
-int main()
+void RunTurnBench(int battleCount, int playersPerBattle, DWORD timeoutMs, int workerCount, int botCount, double seconds)
+{
+	volatile LONG resolvedTurns = 0;
+	TurnCollector collector(battleCount, playersPerBattle, timeoutMs, workerCount,
+		[&resolvedTurns](const TurnResult& result) {
+			// 실제 전투 계산 대신 행동 합계만 구함
+			LONG sum = 0;
+			for (int i = 0; i < result.playerCount; ++i) sum += result.actions[i];
+			InterlockedIncrement(&resolvedTurns);
+			return sum >= 0;
+		});
+
+	volatile bool stop = false;
+	std::vector<BotParam> bots(botCount);
+	std::vector<HANDLE> threads;
+	int perBot = (battleCount + botCount - 1) / botCount;
+	for (int i = 0; i < botCount; ++i) {
+		int first = i * perBot;
+		int last = first + perBot > battleCount ? battleCount : first + perBot;
+		bots[i] = { &collector, first, last, playersPerBattle, &stop, 0, 0 };
+	}
+
+	LARGE_INTEGER frequency, start, end;
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&start);
+	if (!collector.Start()) {
+		std::cout << "턴 수집 서비스 시작 실패!" << std::endl;
+		return;
+	}
+	for (int i = 0; i < botCount; ++i) {
+		HANDLE hThread = (HANDLE)_beginthreadex(nullptr, 0, BotThread, &bots[i], 0, nullptr);
+		if (hThread) threads.push_back(hThread);
+	}
+
+	Sleep((DWORD)(seconds * 1000));
+	stop = true;
+	WaitForMultipleObjects((DWORD)threads.size(), threads.data(), TRUE, INFINITE);
+	for (HANDLE h : threads) CloseHandle(h);
+	collector.Stop();
+	QueryPerformanceCounter(&end);
+	double elapsed = (double)(end.QuadPart - start.QuadPart) / frequency.QuadPart;
+
+	std::vector<double> early, byDeadline;
+	collector.CollectLatencies(early, byDeadline);
+	LONGLONG submitted = 0, rejected = 0;
+	for (const BotParam& bot : bots) {
+		submitted += bot.submitted;
+		rejected += bot.rejected;
+	}
+
+	std::cout << "전투 " << battleCount << "개 x " << playersPerBattle << "명, 작업자 " << workerCount
+		<< ", 제한 시간 " << timeoutMs << "ms" << std::endl;
+	std::cout << "  처리한 턴 " << resolvedTurns << " (" << (LONGLONG)(resolvedTurns / elapsed) << "턴/초), 제출 "
+		<< submitted << ", 늦은 제출 " << rejected << std::endl;
+	std::cout << "  전원 제출 마감 " << early.size() << "턴: 처리 지연 p50 " << Percentile(early, 0.5) / 1000.0
+		<< "ms, p99 " << Percentile(early, 0.99) / 1000.0 << "ms, 최대 " << Percentile(early, 1.0) / 1000.0 << "ms" << std::endl;
+	std::cout << "  시간 초과 마감 " << byDeadline.size() << "턴: 처리 지연 p50 " << Percentile(byDeadline, 0.5) / 1000.0
+		<< "ms, p99 " << Percentile(byDeadline, 0.99) / 1000.0 << "ms, 최대 " << Percentile(byDeadline, 1.0) / 1000.0 << "ms" << std::endl;
+}
+
+void BenchmarkTurnCollection()
 {
+	std::cout << "=== 턴 수집: 처리 지연 = 마감 시점(마지막 제출 또는 제한 시간) ~ 턴 처리 완료 ===" << std::endl;
+	RunTurnBench(1000, 4, 200, 2, 2, 5.0);
+	RunTurnBench(10000, 4, 200, 2, 2, 5.0);
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc > 1 && strcmp(argv[1], "--bench-turns") == 0) {
+		BenchmarkTurnCollection();
+		return 0;
+	}
+
 	srand((unsigned int)time(NULL));
 
+	// 전투 1개, 플레이어 4명, 제한 시간 30초. 턴 결과는 작업자 스레드에서 콜백으로 받음
+	TurnResult turnResult = {};
+	HANDLE hResolved = CreateEvent(NULL, TRUE, FALSE, NULL);
+	TurnCollector collector(1, 4, 30000, 1, [&turnResult, hResolved](const TurnResult& result) {
+		turnResult = result;
+		SetEvent(hResolved);
+		return false;   // 이 예제는 한 턴만 진행
+	});
+	collector.Start();
+
 	// 플레이어 데이터 설정
 	PlayerAction players[4];
 	std::string names[] = { "전사 아서", "마법사 멀린", "도적 로빈", "성기사 갈라하드" };
 
 	for (int i = 0; i < 4; ++i) {
-		players[i] = { i + 1, names[i], "", false, (rand() % 5) + 1 };
+		players[i] = { i + 1, names[i], "", (rand() % 5) + 1, &collector, 1 };
 	}
 
 	HANDLE hThreads[4];
@@ -61,28 +583,25 @@ int main()
 		}
 	}
 
-	// 30초 타임아웃으로 모든 플레이어 선택 대기
-	DWORD waitResult = WaitForMultipleObjects(4, hThreads, TRUE, 30000); // 30초
+	// 전원 제출 또는 30초 마감 중 먼저 오는 쪽에서 턴이 처리됨
+	WaitForSingleObject(hResolved, INFINITE);
 
 	std::cout << "\n=== 선택 시간 종료! ===" << std::endl;
 
-	if (waitResult == WAIT_OBJECT_0) {
+	if (!turnResult.closedByDeadline) {
 		std::cout << "모든 플레이어가 시간 내에 행동을 선택했습니다!" << std::endl;
 	}
-	else if (waitResult == WAIT_TIMEOUT) {
+	else {
 		std::cout << "제한 시간이 초과되었습니다!" << std::endl;
+	}
 
-		// 선택하지 않은 플레이어들 기본 행동 처리
-		for (int i = 0; i < 4; ++i) {
-			if (!players[i].hasSelected) {
-				players[i].action = "기본 공격";
-				std::cout << "[자동 선택] " << players[i].playerName << " -> 기본 공격" << std::endl;
-			}
+	// 선택하지 않은 플레이어들은 처리 단계에서 기본 공격으로 채워짐
+	for (int i = 0; i < 4; ++i) {
+		players[i].action = kActionNames[turnResult.actions[i]];
+		if (turnResult.actions[i] == kActionDefaultAttack) {
+			std::cout << "[자동 선택] " << players[i].playerName << " -> 기본 공격" << std::endl;
 		}
 	}
-	else {
-		std::cout << "대기 중 오류가 발생했습니다!" << std::endl;
-	}
 
 	// 전투 결과 출력
 	std::cout << "\n=== 전투 진행 ===\n" << std::endl;
@@ -94,9 +613,12 @@ int main()
 	std::cout << "\n전투가 완료되었습니다!" << std::endl;
 
 	// 핸들 정리
+	WaitForMultipleObjects(4, hThreads, TRUE, INFINITE);
 	for (int i = 0; i < 4; ++i) {
 		CloseHandle(hThreads[i]);
 	}
+	collector.Stop();
+	CloseHandle(hResolved);
 
 	return 0;
-}
\ No newline at end of file
+}
@@ -1,5 +1,12 @@
 ﻿#include <iostream>
+#include <iomanip>
 #include <vector>
+#include <deque>
+#include <string>
+#include <functional>
+#include <cmath>
+#include <cstring>
+#include <memory>
 #include <windows.h>
 #include <process.h> // _beginthreadex를 위해 필요
 
@@ -45,9 +52,10 @@ unsigned int __stdcall BatchTaskThread(void* pParam)
 	return 0;
 }
 
-int main()
+// 이벤트 방식: 작업마다 스레드를 만들고, 앞 작업의 Event를 기다리게 함
+void RunEventBatch()
 {
-	std::cout << "[조정자] 배치 프로세스를 시작합니다.\n";
+	std::cout << "[조정자] 배치 프로세스를 시작합니다. (이벤트 방식)\n";
 	
 	// Event 생성
 
@@ -80,7 +88,1129 @@ int main()
 	CloseHandle(hThreads[2]);
 	CloseHandle(g_hEvent_A_Done);
 	CloseHandle(g_hEvent_B_Done);
+}
+
+// -----------------------------------------------------------------------------
+// 의존성 그래프(DAG) 스케줄러
+// -----------------------------------------------------------------------------
+// 설명: 이벤트 방식은 작업마다 스레드를 하나씩 만들고, 그 스레드는 앞 작업의
+// Event를 기다리며 대부분의 시간을 잠든 채로 보냅니다.
+// TaskGraph는 작업마다 "아직 끝나지 않은 선행 작업 수"만 세다가 0이 되는 순간
+// 준비 큐에 넣고, 정해진 수의 워커 스레드가 준비된 작업만 꺼내서 실행합니다.
+// 특정 작업의 완료를 기다리며 멈춰 있는 스레드가 없습니다.
+// -----------------------------------------------------------------------------
+class TaskGraph {
+public:
+	// 실행 후 작업별 시간 (그래프 시작 기준, ms)
+	struct NodeTiming {
+		std::string name;
+		double startMs;
+		double endMs;
+		double durationMs;
+		bool onCriticalPath;     // 전체 시간을 결정한 가장 긴 의존 경로에 속하는지
+	};
+
+private:
+	struct TaskNode {
+		std::string name;
+		std::function<void()> work;
+		std::vector<int> predecessors;
+		std::vector<int> successors;
+		volatile LONG pendingCount;  // 아직 끝나지 않은 선행 작업 수
+		LONGLONG startTick;
+		LONGLONG endTick;
+	};
+
+	std::vector<TaskNode> nodes;
+
+	CRITICAL_SECTION cs;             // readyQueue, completedCount 보호
+	CONDITION_VARIABLE readyCond;    // 준비된 작업이 생기거나 전부 끝나면 깨움
+	std::deque<int> readyQueue;
+	size_t completedCount;
+
+	LARGE_INTEGER frequency;
+	LONGLONG graphStartTick;
+
+	static unsigned int __stdcall WorkerThread(void* pParam)
+	{
+		static_cast<TaskGraph*>(pParam)->WorkerLoop();
+		return 0;
+	}
+
+	void WorkerLoop()
+	{
+		std::vector<int> newlyReady;
+
+		EnterCriticalSection(&cs);
+		while (true) {
+			while (readyQueue.empty() && completedCount < nodes.size()) {
+				SleepConditionVariableCS(&readyCond, &cs, INFINITE);
+			}
+			if (readyQueue.empty()) break; // 모든 작업 완료
+
+			int id = readyQueue.front();
+			readyQueue.pop_front();
+			LeaveCriticalSection(&cs);
+
+			// 잠금 밖에서 작업 실행
+			TaskNode& node = nodes[id];
+			LARGE_INTEGER tick;
+			QueryPerformanceCounter(&tick);
+			node.startTick = tick.QuadPart;
+			if (node.work) node.work();
+			QueryPerformanceCounter(&tick);
+			node.endTick = tick.QuadPart;
+
+			// 후속 작업의 남은 선행 작업 수를 줄이고, 0이 된 것만 준비 큐로
+			newlyReady.clear();
+			for (int next : node.successors) {
+				if (InterlockedDecrement(&nodes[next].pendingCount) == 0) newlyReady.push_back(next);
+			}
+
+			EnterCriticalSection(&cs);
+			readyQueue.insert(readyQueue.end(), newlyReady.begin(), newlyReady.end());
+			++completedCount;
+
+			if (completedCount == nodes.size()) {
+				WakeAllConditionVariable(&readyCond); // 다른 워커들도 종료하도록
+			}
+			else {
+				// 하나는 이 스레드가 바로 가져가므로 나머지 개수만큼만 깨움
+				for (size_t i = 1; i < newlyReady.size(); ++i) WakeConditionVariable(&readyCond);
+			}
+		}
+		LeaveCriticalSection(&cs);
+	}
+
+public:
+	TaskGraph() : completedCount(0), graphStartTick(0) {
+		InitializeCriticalSection(&cs);
+		InitializeConditionVariable(&readyCond);
+		QueryPerformanceFrequency(&frequency);
+	}
+
+	~TaskGraph() {
+		DeleteCriticalSection(&cs);
+	}
+
+	// 작업 추가. 의존 작업은 먼저 추가되어 있어야 하므로 순환이 생길 수 없음
+	// 반환값: 작업 번호 (잘못된 의존 번호가 있으면 -1)
+	int AddTask(const std::string& name, std::function<void()> work, const std::vector<int>& dependencies = std::vector<int>())
+	{
+		int id = (int)nodes.size();
+		for (int dep : dependencies) {
+			if (dep < 0 || dep >= id) return -1;
+		}
+
+		TaskNode node;
+		node.name = name;
+		node.work = std::move(work);
+		node.predecessors = dependencies;
+		node.pendingCount = 0;
+		node.startTick = node.endTick = 0;
+		nodes.push_back(std::move(node));
+
+		for (int dep : dependencies) nodes[dep].successors.push_back(id);
+		return id;
+	}
+
+	size_t GetTaskCount() const { return nodes.size(); }
+
+	// workerCount개의 워커로 그래프 전체를 실행하고 끝날 때까지 대기
+	bool Run(int workerCount)
+	{
+		if (nodes.empty()) return true;
+		if (workerCount < 1) workerCount = 1;
+
+		readyQueue.clear();
+		completedCount = 0;
+		for (size_t i = 0; i < nodes.size(); ++i) {
+			nodes[i].pendingCount = (LONG)nodes[i].predecessors.size();
+			if (nodes[i].pendingCount == 0) readyQueue.push_back((int)i);
+		}
+
+		LARGE_INTEGER tick;
+		QueryPerformanceCounter(&tick);
+		graphStartTick = tick.QuadPart;
+
+		std::vector<HANDLE> workers;
+		for (int i = 0; i < workerCount; ++i) {
+			HANDLE hThread = (HANDLE)_beginthreadex(NULL, 0, WorkerThread, this, 0, NULL);
+			if (hThread) workers.push_back(hThread);
+		}
+		if (workers.empty()) return false;
+
+		WaitForMultipleObjects((DWORD)workers.size(), workers.data(), TRUE, INFINITE);
+		for (HANDLE h : workers) CloseHandle(h);
+		return completedCount == nodes.size();
+	}
+
+	// 작업별 시간과 임계 경로(실제 실행 시간 기준 가장 긴 의존 경로) 계산
+	std::vector<NodeTiming> GetTimings() const
+	{
+		std::vector<NodeTiming> timings(nodes.size());
+		std::vector<double> pathMs(nodes.size(), 0.0);   // 이 작업에서 끝나는 가장 긴 경로
+		std::vector<int> pathPrev(nodes.size(), -1);
+
+		for (size_t i = 0; i < nodes.size(); ++i) {       // 번호 순서 = 위상 정렬 순서
+			const TaskNode& node = nodes[i];
+			NodeTiming& t = timings[i];
+			t.name = node.name;
+			t.startMs = (double)(node.startTick - graphStartTick) * 1000.0 / frequency.QuadPart;
+			t.endMs = (double)(node.endTick - graphStartTick) * 1000.0 / frequency.QuadPart;
+			t.durationMs = t.endMs - t.startMs;
+			t.onCriticalPath = false;
+
+			for (int dep : node.predecessors) {
+				if (pathMs[dep] > pathMs[i]) {
+					pathMs[i] = pathMs[dep];
+					pathPrev[i] = dep;
+				}
+			}
+			pathMs[i] += t.durationMs;
+		}
+
+		int last = 0;
+		for (size_t i = 1; i < nodes.size(); ++i) {
+			if (pathMs[i] > pathMs[last]) last = (int)i;
+		}
+		for (int id = last; id >= 0 && !nodes.empty(); id = pathPrev[id]) timings[id].onCriticalPath = true;
+		return timings;
+	}
+
+	void PrintReport() const
+	{
+		std::vector<NodeTiming> timings = GetTimings();
+		double makespan = 0, criticalMs = 0;
+
+		std::cout << "\n[조정자] 작업별 실행 시간 (* = 임계 경로)\n";
+		for (const NodeTiming& t : timings) {
+			std::cout << (t.onCriticalPath ? " * " : "   ") << std::left << std::setw(20) << t.name << std::right << std::fixed << std::setprecision(1)
+				<< " 시작 " << std::setw(8) << t.startMs << "ms  종료 " << std::setw(8) << t.endMs
+				<< "ms  소요 " << std::setw(8) << t.durationMs << "ms\n";
+			if (t.endMs > makespan) makespan = t.endMs;
+			if (t.onCriticalPath) criticalMs += t.durationMs;
+		}
+		std::cout << "[조정자] 전체 " << makespan << "ms, 임계 경로 합 " << criticalMs << "ms\n";
+		std::cout.unsetf(std::ios::fixed);
+	}
+};
+
+// DAG 방식: 같은 A -> B -> C 흐름에 B와 병렬로 돌 수 있는 검증 작업(V)을 추가
+void RunGraphBatch()
+{
+	std::cout << "\n[조정자] 배치 프로세스를 시작합니다. (DAG 스케줄러 방식)\n";
+
+	TaskGraph graph;
+	int taskA = graph.AddTask("A 데이터 준비", []() {
+		std::cout << "[Task A] 시작: 데이터 준비 작업을 수행합니다.\n";
+		Sleep(2000);
+		std::cout << "[Task A] 완료\n";
+	});
+	int taskB = graph.AddTask("B 데이터 처리", []() {
+		std::cout << "[Task B] 시작: 데이터 처리 작업을 수행합니다.\n";
+		Sleep(3000);
+		std::cout << "[Task B] 완료\n";
+	}, { taskA });
+	int taskV = graph.AddTask("V 데이터 검증", []() {
+		std::cout << "[Task V] 시작: B와 동시에 데이터 검증을 수행합니다.\n";
+		Sleep(1000);
+		std::cout << "[Task V] 완료\n";
+	}, { taskA });
+	graph.AddTask("C 결과 리포팅", []() {
+		std::cout << "[Task C] 시작: 결과 리포팅 작업을 수행합니다.\n";
+		Sleep(1500);
+		std::cout << "[Task C] 완료: 모든 작업이 끝났습니다.\n";
+	}, { taskB, taskV });
+
+	// 워커 2개면 B와 V가 동시에 실행됨. 선행 작업을 기다리며 막혀 있는 스레드는 없음
+	graph.Run(2);
+	std::cout << "[조정자] 배치 프로세스가 모두 완료되었습니다.\n";
+	graph.PrintReport();
+}
+
+// -----------------------------------------------------------------------------
+// 벤치마크: 1,000개로 퍼졌다가 하나로 모이는(fan-out/fan-in) 그래프
+// -----------------------------------------------------------------------------
+volatile double g_benchSink = 0; // 계산 결과를 버리지 않도록 저장
+
+void BusyWork(int iterations)
+{
+	double x = 0;
+	for (int i = 0; i < iterations; ++i) x += std::sqrt((double)i);
+	g_benchSink = x;
+}
+
+struct EventNodeParam {
+	std::vector<HANDLE>* events;
+	std::vector<int> predecessors;
+	int id;
+	int iterations;
+};
+
+// 이벤트 방식 노드: 선행 작업의 Event를 모두 기다린 뒤 실행하고 자기 Event를 켬
+unsigned int __stdcall EventNodeThread(void* pParam)
+{
+	EventNodeParam* param = static_cast<EventNodeParam*>(pParam);
+	for (int dep : param->predecessors) {
+		WaitForSingleObject((*param->events)[dep], INFINITE); // 64개 제한 때문에 하나씩 대기
+	}
+	BusyWork(param->iterations);
+	SetEvent((*param->events)[param->id]);
+	return 0;
+}
+
+ULONGLONG GetProcessCpuMs()
+{
+	FILETIME creation, exitTime, kernel, user;
+	GetProcessTimes(GetCurrentProcess(), &creation, &exitTime, &kernel, &user);
+	ULONGLONG k = ((ULONGLONG)kernel.dwHighDateTime << 32) | kernel.dwLowDateTime;
+	ULONGLONG u = ((ULONGLONG)user.dwHighDateTime << 32) | user.dwLowDateTime;
+	return (k + u) / 10000;
+}
+
+void BenchmarkFanOutFanIn()
+{
+	const int width = 1000;
+	const int iterations = 20000;
+	const int nodeCount = width + 2;     // 시작 1 + 가운데 1000 + 끝 1
+
+	SYSTEM_INFO si;
+	GetSystemInfo(&si);
+	int workerCount = (int)si.dwNumberOfProcessors;
+
+	// 그래프 모양: 0 -> (1..1000) -> 1001
+	std::vector<std::vector<int>> deps(nodeCount);
+	for (int i = 1; i <= width; ++i) deps[i].push_back(0);
+	for (int i = 1; i <= width; ++i) deps[width + 1].push_back(i);
+
+	LARGE_INTEGER freq, start, end;
+	QueryPerformanceFrequency(&freq);
+
+	std::cout << "=== fan-out/fan-in 벤치마크 (작업 " << nodeCount << "개) ===\n";
+
+	// 1) 이벤트 방식: 작업마다 스레드 하나 + 간선마다 Event 대기
+	{
+		std::vector<HANDLE> events(nodeCount);
+		for (auto& h : events) h = CreateEvent(NULL, TRUE, FALSE, NULL);
+		std::vector<EventNodeParam> params(nodeCount);
+		std::vector<HANDLE> threads;
+
+		ULONGLONG cpuBefore = GetProcessCpuMs();
+		QueryPerformanceCounter(&start);
+		for (int i = 0; i < nodeCount; ++i) {
+			params[i].events = &events;
+			params[i].predecessors = deps[i];
+			params[i].id = i;
+			params[i].iterations = iterations;
+			HANDLE hThread = (HANDLE)_beginthreadex(NULL, 64 * 1024, EventNodeThread, &params[i], STACK_SIZE_PARAM_IS_A_RESERVATION, NULL);
+			if (hThread) threads.push_back(hThread);
+		}
+		WaitForSingleObject(events[nodeCount - 1], INFINITE);
+		QueryPerformanceCounter(&end);
+		ULONGLONG cpuUsed = GetProcessCpuMs() - cpuBefore;
+
+		for (HANDLE h : threads) { WaitForSingleObject(h, INFINITE); CloseHandle(h); }
+		for (HANDLE h : events) CloseHandle(h);
+
+		std::cout << "이벤트 방식 (스레드 " << threads.size() << "개): "
+			<< (double)(end.QuadPart - start.QuadPart) * 1000.0 / freq.QuadPart << "ms, CPU " << cpuUsed << "ms\n";
+	}
+
+	// 2) DAG 스케줄러: 워커는 CPU 수만큼
+	{
+		TaskGraph graph;
+		for (int i = 0; i < nodeCount; ++i) {
+			graph.AddTask("node " + std::to_string(i), [iterations]() { BusyWork(iterations); }, deps[i]);
+		}
+
+		ULONGLONG cpuBefore = GetProcessCpuMs();
+		QueryPerformanceCounter(&start);
+		graph.Run(workerCount);
+		QueryPerformanceCounter(&end);
+		ULONGLONG cpuUsed = GetProcessCpuMs() - cpuBefore;
+
+		double criticalMs = 0;
+		for (const auto& t : graph.GetTimings()) {
+			if (t.onCriticalPath) criticalMs += t.durationMs;
+		}
+		std::cout << "DAG 스케줄러 (워커 " << workerCount << "개): "
+			<< (double)(end.QuadPart - start.QuadPart) * 1000.0 / freq.QuadPart << "ms, CPU " << cpuUsed
+			<< "ms, 임계 경로 " << criticalMs << "ms\n";
+	}
+}
+
+// -----------------------------------------------------------------------------
+// 파이프라인 방식: 데이터를 청크로 나눠 A, B, C가 서로 다른 청크를 동시에 처리
+// -----------------------------------------------------------------------------
+// 설명: 단계별로 "전부 끝나면 다음 단계" 방식은 A가 모든 데이터를 준비할 때까지
+// B가 놀고, C는 B가 전부 끝날 때까지 놉니다.
+// 파이프라인은 청크 하나가 A를 통과하면 바로 B로 넘기고, 단계 사이에는 크기가
+// 정해진 SPSC 링을 둡니다. 링이 가득 차면 앞 단계가 기다리므로(backpressure)
+// 빠른 단계가 메모리를 무한정 쌓지 않습니다.
+// 단계마다 스레드 수를 다르게 줄 수 있고, 생산자 워커 x 소비자 워커 쌍마다 링을
+// 하나씩 두어 모든 링이 생산자 1명, 소비자 1명을 유지합니다.
+// -----------------------------------------------------------------------------
+#pragma comment(lib, "Synchronization.lib") // WaitOnAddress / WakeByAddress
+
+struct BatchChunk {
+	int index;
+	std::vector<int> data;
+	long long result;
+};
+
+struct PipelineStage {
+	std::string name;
+	int parallelism;                           // 이 단계를 처리할 스레드 수
+	std::function<void(BatchChunk&)> process;
+};
+
+struct PipelineStats {
+	double totalMs;          // 전체 처리 시간
+	double firstResultMs;    // 첫 청크가 마지막 단계를 통과한 시간
+	double chunksPerSec;
+	long long checksum;      // 방식이 달라도 결과가 같은지 확인용
+};
+
+// 생산자 1명, 소비자 1명인 고정 크기 링. nullptr은 "더 보낼 청크 없음" 표시
+class ChunkRing {
+private:
+	std::vector<BatchChunk*> slots;
+	LONG capacity;
+	volatile LONG head;      // 생산자만 씀
+	char pad[64];            // head/tail이 같은 캐시 라인을 공유하지 않도록
+	volatile LONG tail;      // 소비자만 씀
+
+public:
+	explicit ChunkRing(LONG cap) : slots(cap), capacity(cap), head(0), tail(0) {}
+
+	// 가득 차 있으면 소비자가 하나 꺼낼 때까지 기다림 (backpressure)
+	void Push(BatchChunk* chunk)
+	{
+		LONG observedTail = tail;
+		while (head - observedTail == capacity) {
+			WaitOnAddress(&tail, &observedTail, sizeof(LONG), INFINITE);
+			observedTail = tail;
+		}
+		slots[head % capacity] = chunk;
+		InterlockedExchange(&head, head + 1);   // 슬롯을 쓴 뒤에 공개
+	}
+
+	bool TryPop(BatchChunk*& chunk)
+	{
+		if (tail == head) return false;
+		chunk = slots[tail % capacity];
+		InterlockedExchange(&tail, tail + 1);
+		WakeByAddressSingle((PVOID)&tail);      // 가득 차서 기다리던 생산자를 깨움
+		return true;
+	}
+};
+
+class BatchPipeline {
+private:
+	struct StageWorker {
+		BatchPipeline* owner;
+		int stage;
+		int index;
+		volatile LONG inputSignal;   // 입력 링에 청크가 들어올 때마다 증가
+	};
+
+	std::vector<PipelineStage> stages;
+	LONG ringCapacity;
+	int chunkCount;
+
+	// rings[k][p][c]: k단계의 p번 워커 -> k+1단계의 c번 워커
+	std::vector<std::vector<std::vector<std::unique_ptr<ChunkRing>>>> rings;
+	std::vector<std::vector<std::unique_ptr<StageWorker>>> workers;
+
+	LARGE_INTEGER frequency;
+	LONGLONG startTick;
+	volatile LONGLONG firstResultTick;
+	volatile LONGLONG checksum;
+
+	static unsigned int __stdcall WorkerThread(void* pParam)
+	{
+		StageWorker* worker = static_cast<StageWorker*>(pParam);
+		worker->owner->WorkerLoop(*worker);
+		return 0;
+	}
+
+	// 청크 번호로 다음 단계 워커를 골라 넘김
+	void Forward(int stage, int from, BatchChunk* chunk)
+	{
+		int to = chunk->index % stages[stage + 1].parallelism;
+		rings[stage][from][to]->Push(chunk);
+		Signal(*workers[stage + 1][to]);
+	}
+
+	void Signal(StageWorker& target)
+	{
+		InterlockedIncrement(&target.inputSignal);
+		WakeByAddressSingle((PVOID)&target.inputSignal);
+	}
+
+	void Complete(BatchChunk* chunk)
+	{
+		LARGE_INTEGER now;
+		QueryPerformanceCounter(&now);
+		InterlockedCompareExchange64(&firstResultTick, now.QuadPart, 0);
+		InterlockedExchangeAdd64(&checksum, chunk->result);
+		delete chunk;
+	}
+
+	void WorkerLoop(StageWorker& worker)
+	{
+		const int k = worker.stage;
+		const bool isLast = (k == (int)stages.size() - 1);
+		PipelineStage& stage = stages[k];
+
+		if (k == 0) {
+			// 첫 단계: 자기 몫의 청크를 만들어서 처리
+			for (int i = worker.index; i < chunkCount; i += stage.parallelism) {
+				BatchChunk* chunk = new BatchChunk();
+				chunk->index = i;
+				chunk->result = 0;
+				stage.process(*chunk);
+				if (isLast) Complete(chunk);
+				else Forward(k, worker.index, chunk);
+			}
+		}
+		else {
+			// 앞 단계 워커마다 링이 하나씩 있으므로 돌아가며 꺼냄
+			int producers = stages[k - 1].parallelism;
+			int finishedProducers = 0;
+			std::vector<bool> finished(producers, false);
+			int next = 0;
+
+			while (finishedProducers < producers) {
+				LONG seen = worker.inputSignal;   // 링을 보기 전에 읽어야 신호를 놓치지 않음
+				bool gotAny = false;
+
+				for (int n = 0; n < producers; ++n) {
+					int p = (next + n) % producers;
+					BatchChunk* chunk = nullptr;
+					if (finished[p] || !rings[k - 1][p][worker.index]->TryPop(chunk)) continue;
+
+					gotAny = true;
+					next = (p + 1) % producers;
+					if (chunk == nullptr) {
+						finished[p] = true;
+						++finishedProducers;
+						continue;
+					}
+					stage.process(*chunk);
+					if (isLast) Complete(chunk);
+					else Forward(k, worker.index, chunk);
+					break;
+				}
+
+				if (!gotAny) {
+					while (worker.inputSignal == seen) {
+						WaitOnAddress(&worker.inputSignal, &seen, sizeof(LONG), INFINITE);
+					}
+				}
+			}
+		}
+
+		// 다음 단계 워커들에게 끝났다고 알림
+		if (!isLast) {
+			for (int to = 0; to < stages[k + 1].parallelism; ++to) {
+				rings[k][worker.index][to]->Push(nullptr);
+				Signal(*workers[k + 1][to]);
+			}
+		}
+	}
+
+public:
+	BatchPipeline(const std::vector<PipelineStage>& stageList, LONG capacity)
+		: stages(stageList), ringCapacity(capacity), chunkCount(0), startTick(0), firstResultTick(0), checksum(0)
+	{
+		QueryPerformanceFrequency(&frequency);
+		for (auto& stage : stages) {
+			if (stage.parallelism < 1) stage.parallelism = 1;
+		}
+	}
+
+	// 단계별 스레드를 모두 띄워서 chunks개의 청크를 흘려보냄
+	PipelineStats Run(int chunks)
+	{
+		chunkCount = chunks;
+		firstResultTick = 0;
+		checksum = 0;
+
+		rings.clear();
+		rings.resize(stages.size() - 1);
+		for (size_t k = 0; k + 1 < stages.size(); ++k) {
+			rings[k].resize(stages[k].parallelism);
+			for (auto& row : rings[k]) {
+				for (int c = 0; c < stages[k + 1].parallelism; ++c) row.emplace_back(new ChunkRing(ringCapacity));
+			}
+		}
+
+		workers.clear();
+		workers.resize(stages.size());
+		for (size_t k = 0; k < stages.size(); ++k) {
+			for (int w = 0; w < stages[k].parallelism; ++w) {
+				StageWorker* worker = new StageWorker();
+				worker->owner = this;
+				worker->stage = (int)k;
+				worker->index = w;
+				worker->inputSignal = 0;
+				workers[k].emplace_back(worker);
+			}
+		}
+
+		LARGE_INTEGER tick;
+		QueryPerformanceCounter(&tick);
+		startTick = tick.QuadPart;
+
+		std::vector<HANDLE> threads;
+		for (auto& stageWorkers : workers) {
+			for (auto& worker : stageWorkers) {
+				HANDLE hThread = (HANDLE)_beginthreadex(NULL, 0, WorkerThread, worker.get(), 0, NULL);
+				if (hThread) threads.push_back(hThread);
+			}
+		}
+		for (HANDLE h : threads) {
+			WaitForSingleObject(h, INFINITE);
+			CloseHandle(h);
+		}
+
+		QueryPerformanceCounter(&tick);
+		PipelineStats stats;
+		stats.totalMs = (double)(tick.QuadPart - startTick) * 1000.0 / frequency.QuadPart;
+		stats.firstResultMs = (double)(firstResultTick - startTick) * 1000.0 / frequency.QuadPart;
+		stats.chunksPerSec = chunks * 1000.0 / stats.totalMs;
+		stats.checksum = checksum;
+		return stats;
+	}
+};
+
+// 비교용: 단계마다 모든 청크를 처리한 뒤에야 다음 단계를 시작 (기존 방식)
+struct BarrierStageParam {
+	PipelineStage* stage;
+	std::vector<BatchChunk>* chunks;
+	int worker;
+	bool isLast;
+	volatile LONGLONG* firstResultTick;
+};
+
+unsigned int __stdcall BarrierStageThread(void* pParam)
+{
+	BarrierStageParam* param = static_cast<BarrierStageParam*>(pParam);
+	for (size_t i = param->worker; i < param->chunks->size(); i += param->stage->parallelism) {
+		param->stage->process((*param->chunks)[i]);
+		if (param->isLast) {
+			LARGE_INTEGER now;
+			QueryPerformanceCounter(&now);
+			InterlockedCompareExchange64(param->firstResultTick, now.QuadPart, 0);
+		}
+	}
+	return 0;
+}
+
+PipelineStats RunBarrierBatch(std::vector<PipelineStage> stages, int chunkCount)
+{
+	LARGE_INTEGER freq, start, end;
+	QueryPerformanceFrequency(&freq);
+	volatile LONGLONG firstResultTick = 0;
+
+	std::vector<BatchChunk> chunks(chunkCount);
+	for (int i = 0; i < chunkCount; ++i) {
+		chunks[i].index = i;
+		chunks[i].result = 0;
+	}
+
+	QueryPerformanceCounter(&start);
+	for (size_t k = 0; k < stages.size(); ++k) {
+		int parallelism = stages[k].parallelism < 1 ? 1 : stages[k].parallelism;
+		stages[k].parallelism = parallelism;
+
+		std::vector<BarrierStageParam> params(parallelism);
+		std::vector<HANDLE> threads;
+		for (int w = 0; w < parallelism; ++w) {
+			params[w] = { &stages[k], &chunks, w, k + 1 == stages.size(), &firstResultTick };
+			HANDLE hThread = (HANDLE)_beginthreadex(NULL, 0, BarrierStageThread, &params[w], 0, NULL);
+			if (hThread) threads.push_back(hThread);
+		}
+		// 이 단계의 모든 청크가 끝날 때까지 다음 단계는 시작하지 않음
+		for (HANDLE h : threads) {
+			WaitForSingleObject(h, INFINITE);
+			CloseHandle(h);
+		}
+	}
+	QueryPerformanceCounter(&end);
+
+	PipelineStats stats;
+	stats.totalMs = (double)(end.QuadPart - start.QuadPart) * 1000.0 / freq.QuadPart;
+	stats.firstResultMs = (double)(firstResultTick - start.QuadPart) * 1000.0 / freq.QuadPart;
+	stats.chunksPerSec = chunkCount * 1000.0 / stats.totalMs;
+	stats.checksum = 0;
+	for (const auto& chunk : chunks) stats.checksum += chunk.result;
+	return stats;
+}
+
+// A(준비 2초) -> B(처리 3초) -> C(리포팅 1.5초)를 chunkCount개로 나눈 단계 정의
+std::vector<PipelineStage> MakeBatchStages(int chunkCount, int parallelismA, int parallelismB, int parallelismC)
+{
+	std::vector<PipelineStage> stages;
+	stages.push_back({ "A 데이터 준비", parallelismA, [chunkCount](BatchChunk& chunk) {
+		Sleep(2000 / chunkCount);
+		chunk.data.resize(1000);
+		for (int i = 0; i < (int)chunk.data.size(); ++i) chunk.data[i] = chunk.index * 1000 + i;
+	} });
+	stages.push_back({ "B 데이터 처리", parallelismB, [chunkCount](BatchChunk& chunk) {
+		Sleep(3000 / chunkCount);
+		for (int& v : chunk.data) v = v * 2 + 1;
+	} });
+	stages.push_back({ "C 결과 리포팅", parallelismC, [chunkCount](BatchChunk& chunk) {
+		Sleep(1500 / chunkCount);
+		chunk.result = 0;
+		for (int v : chunk.data) chunk.result += v;
+	} });
+	return stages;
+}
+
+void PrintPipelineStats(const char* label, const PipelineStats& stats)
+{
+	std::cout << std::left << std::setw(28) << label << std::right << std::fixed << std::setprecision(1)
+		<< " 전체 " << std::setw(7) << stats.totalMs << "ms | 첫 결과 " << std::setw(7) << stats.firstResultMs
+		<< "ms | 처리량 " << std::setw(6) << stats.chunksPerSec << " 청크/초 | 검증합 " << stats.checksum << "\n";
+	std::cout.unsetf(std::ios::fixed);
+}
+
+void RunPipelineBatch()
+{
+	const int chunkCount = 10;
+	std::cout << "\n[조정자] 배치 프로세스를 시작합니다. (파이프라인 방식, 청크 " << chunkCount << "개)\n";
+
+	BatchPipeline pipeline(MakeBatchStages(chunkCount, 1, 1, 1), 2);
+	PipelineStats stats = pipeline.Run(chunkCount);
+	std::cout << "[조정자] 배치 프로세스가 모두 완료되었습니다.\n";
+	PrintPipelineStats("파이프라인 (A1/B1/C1)", stats);
+}
+
+void BenchmarkPipeline()
+{
+	const int chunkCount = 20;
+	const LONG ringCapacity = 2;
+
+	std::cout << "=== 단계별 배리어 vs 파이프라인 (청크 " << chunkCount << "개, 링 크기 " << ringCapacity << ") ===\n";
+	PrintPipelineStats("배리어 (A1/B1/C1)", RunBarrierBatch(MakeBatchStages(chunkCount, 1, 1, 1), chunkCount));
+	PrintPipelineStats("배리어 (A1/B2/C1)", RunBarrierBatch(MakeBatchStages(chunkCount, 1, 2, 1), chunkCount));
+
+	BatchPipeline serial(MakeBatchStages(chunkCount, 1, 1, 1), ringCapacity);
+	PrintPipelineStats("파이프라인 (A1/B1/C1)", serial.Run(chunkCount));
+
+	// 가장 느린 B 단계에 스레드를 더 주면 병목이 줄어듦
+	BatchPipeline wideB(MakeBatchStages(chunkCount, 1, 2, 1), ringCapacity);
+	PrintPipelineStats("파이프라인 (A1/B2/C1)", wideB.Run(chunkCount));
+
+	BatchPipeline wide(MakeBatchStages(chunkCount, 2, 3, 2), ringCapacity);
+	PrintPipelineStats("파이프라인 (A2/B3/C2)", wide.Run(chunkCount));
+}
+
+// -----------------------------------------------------------------------------
+// 체크포인트/재시작: 완료한 청크를 추가 전용 파일에 남겨 두고, 다시 실행하면 이어서 처리
+// -----------------------------------------------------------------------------
+// 설명: 지금까지의 배치는 진행 상황이 메모리에만 있어서 B 도중에 프로세스가 죽으면
+// A부터 다시 해야 합니다.
+// 레코드 형식: 매직(4) 단계(4) 청크(4) 길이(4) 내용 CRC32(4)
+//   청크 번호가 kStageDoneChunk이면 "이 단계 전체 완료" 표시 (내용 없음)
+// 레코드는 메모리에 모았다가 syncEvery개마다 WriteFile + FlushFileBuffers로 한 번에
+// 내립니다. FlushFileBuffers까지 끝난 레코드만 커밋된 것으로 보고, 쓰다가 죽어서
+// 반쯤 남은 꼬리 레코드는 다시 열 때 CRC 검사로 걸러내고 잘라냅니다.
+// -----------------------------------------------------------------------------
+UINT32 Crc32(const void* data, size_t size)
+{
+	static UINT32 table[256];
+	static bool initialized = false;
+	if (!initialized) {
+		for (UINT32 i = 0; i < 256; ++i) {
+			UINT32 c = i;
+			for (int bit = 0; bit < 8; ++bit) c = (c & 1) ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+			table[i] = c;
+		}
+		initialized = true;
+	}
+
+	const unsigned char* bytes = static_cast<const unsigned char*>(data);
+	UINT32 crc = 0xFFFFFFFF;
+	for (size_t i = 0; i < size; ++i) crc = table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+	return crc ^ 0xFFFFFFFF;
+}
+
+class CheckpointLog {
+public:
+	static const UINT32 kMagic = 0x4B504843;          // "CHPK"
+	static const UINT32 kStageDoneChunk = 0xFFFFFFFF;
+
+	struct Record {
+		UINT32 stage;
+		UINT32 chunk;
+		std::string payload;
+	};
+
+private:
+	static const UINT32 kHeaderSize = 16;    // 매직, 단계, 청크, 길이
+	static const UINT32 kMaxPayload = 16 * 1024 * 1024;
+
+	HANDLE hFile;
+	std::string pending;     // 아직 디스크에 내리지 않은 레코드
+	int pendingCount;
+	int syncEvery;
+	int syncCount;
+	LONGLONG bytesWritten;
+	LONGLONG committedEnd;   // 디스크에 온전히 내려간 마지막 레코드의 끝 위치
+	DWORD lastError;
+
+public:
+	CheckpointLog() : hFile(INVALID_HANDLE_VALUE), pendingCount(0), syncEvery(1), syncCount(0), bytesWritten(0),
+		committedEnd(0), lastError(ERROR_SUCCESS) {}
+	~CheckpointLog() { Close(); }
+
+	// 파일을 열고(없으면 생성) 커밋된 레코드를 모두 읽어 옴. 손상된 꼬리는 잘라냄
+	bool Open(const char* path, int syncEveryRecords, std::vector<Record>& committed)
+	{
+		syncEvery = syncEveryRecords < 1 ? 1 : syncEveryRecords;
+		hFile = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, 0, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (hFile == INVALID_HANDLE_VALUE) {
+			std::cerr << "체크포인트 파일을 열 수 없습니다: " << path << " (오류 " << GetLastError() << ")\n";
+			return false;
+		}
+
+		LARGE_INTEGER fileSize;
+		GetFileSizeEx(hFile, &fileSize);
+		std::string contents((size_t)fileSize.QuadPart, '\0');
+		DWORD totalRead = 0;
+		while (totalRead < contents.size()) {
+			DWORD bytesRead = 0;
+			if (!ReadFile(hFile, &contents[totalRead], (DWORD)contents.size() - totalRead, &bytesRead, NULL) || bytesRead == 0) break;
+			totalRead += bytesRead;
+		}
+		contents.resize(totalRead);
+
+		size_t offset = 0;
+		while (contents.size() - offset >= kHeaderSize + sizeof(UINT32)) {
+			UINT32 header[4];
+			memcpy(header, contents.data() + offset, kHeaderSize);
+			if (header[0] != kMagic || header[3] > kMaxPayload) break;
+
+			size_t recordSize = kHeaderSize + header[3] + sizeof(UINT32);
+			if (contents.size() - offset < recordSize) break;
+
+			UINT32 storedCrc;
+			memcpy(&storedCrc, contents.data() + offset + kHeaderSize + header[3], sizeof(UINT32));
+			if (storedCrc != Crc32(contents.data() + offset, kHeaderSize + header[3])) break;
+
+			Record record;
+			record.stage = header[1];
+			record.chunk = header[2];
+			record.payload.assign(contents.data() + offset + kHeaderSize, header[3]);
+			committed.push_back(record);
+			offset += recordSize;
+		}
+
+		// 마지막으로 온전한 레코드 뒤부터 잘라내고 그 위치에 이어서 씀
+		LARGE_INTEGER validEnd;
+		validEnd.QuadPart = (LONGLONG)offset;
+		SetFilePointerEx(hFile, validEnd, NULL, FILE_BEGIN);
+		if (offset < contents.size()) SetEndOfFile(hFile);
+		committedEnd = validEnd.QuadPart;
+		return true;
+	}
+
+	// sync까지 이어졌다면 그 결과를 반환 (실패하면 레코드는 pending에 남음)
+	bool Append(UINT32 stage, UINT32 chunk, const void* payload, UINT32 size)
+	{
+		size_t start = pending.size();
+		UINT32 header[4] = { kMagic, stage, chunk, size };
+		pending.append(reinterpret_cast<const char*>(header), kHeaderSize);
+		if (size > 0) pending.append(static_cast<const char*>(payload), size);
+		UINT32 crc = Crc32(pending.data() + start, kHeaderSize + size);
+		pending.append(reinterpret_cast<const char*>(&crc), sizeof(UINT32));
+
+		if (++pendingCount >= syncEvery) return Sync();
+		return true;
+	}
+
+	// 모아 둔 레코드를 한 번에 쓰고 디스크까지 내림
+	// 쓰기가 짧거나 실패하면 이번에 쓴 부분을 잘라내고 pending을 그대로 둠.
+	// 복구 쪽은 디스크에 있는 레코드를 믿으므로 내려가지 않은 배치를 커밋으로 세지 않음
+	bool Sync()
+	{
+		if (hFile == INVALID_HANDLE_VALUE) {
+			lastError = ERROR_INVALID_HANDLE;
+			return pending.empty();
+		}
+		if (pending.empty()) return true;
+
+		DWORD written = 0;
+		BOOL ok = WriteFile(hFile, pending.data(), (DWORD)pending.size(), &written, NULL);
+		if (!ok || written != pending.size()) {
+			lastError = ok ? ERROR_WRITE_FAULT : GetLastError();
+		}
+		else if (!FlushFileBuffers(hFile)) {
+			lastError = GetLastError();
+			ok = FALSE;
+		}
+
+		if (!ok || written != pending.size()) {
+			// 다음 시도가 찢어진 레코드 뒤에 이어 쓰지 않도록 마지막 커밋 위치로 되돌림
+			LARGE_INTEGER end;
+			end.QuadPart = committedEnd;
+			SetFilePointerEx(hFile, end, NULL, FILE_BEGIN);
+			SetEndOfFile(hFile);
+			return false;
+		}
+
+		committedEnd += written;
+		bytesWritten += written;
+		++syncCount;
+		pending.clear();
+		pendingCount = 0;
+		return true;
+	}
+
+	// 남은 레코드를 내리고 닫음. 내리지 못했으면 false
+	bool Close()
+	{
+		bool synced = Sync();
+		if (hFile != INVALID_HANDLE_VALUE) {
+			CloseHandle(hFile);
+			hFile = INVALID_HANDLE_VALUE;
+		}
+		return synced;
+	}
+
+	// 프로세스가 죽은 상황 흉내: 커밋하지 않은 레코드는 버림
+	void Abandon()
+	{
+		pending.clear();
+		pendingCount = 0;
+		Close();
+	}
+
+	int GetSyncCount() const { return syncCount; }
+	DWORD GetLastErrorCode() const { return lastError; }
+	LONGLONG GetBytesWritten() const { return bytesWritten; }
+};
+
+struct CheckpointRunStats {
+	bool completed;
+	double totalMs;
+	double recoveryMs;       // 로그를 읽고 상태를 복원하는 데 걸린 시간
+	double checkpointMs;     // 레코드 기록과 FlushFileBuffers에 쓴 시간
+	int skippedSteps;        // 이미 커밋돼 있어서 건너뛴 (단계, 청크) 수
+	int executedSteps;
+	int syncCount;
+	long long checksum;
+	DWORD ioError;           // 체크포인트를 디스크에 내리지 못해 중단했으면 오류 코드
+};
+
+// 청크 내용 = result(8) + 개수(4) + 데이터
+void EncodeChunk(const BatchChunk& chunk, std::string& out)
+{
+	UINT32 count = (UINT32)chunk.data.size();
+	out.assign(reinterpret_cast<const char*>(&chunk.result), sizeof(chunk.result));
+	out.append(reinterpret_cast<const char*>(&count), sizeof(count));
+	if (count > 0) out.append(reinterpret_cast<const char*>(chunk.data.data()), count * sizeof(int));
+}
+
+bool DecodeChunk(const std::string& payload, BatchChunk& chunk)
+{
+	UINT32 count = 0;
+	if (payload.size() < sizeof(chunk.result) + sizeof(count)) return false;
+	memcpy(&chunk.result, payload.data(), sizeof(chunk.result));
+	memcpy(&count, payload.data() + sizeof(chunk.result), sizeof(count));
+	if (payload.size() != sizeof(chunk.result) + sizeof(count) + count * sizeof(int)) return false;
+	chunk.data.resize(count);
+	if (count > 0) memcpy(chunk.data.data(), payload.data() + sizeof(chunk.result) + sizeof(count), count * sizeof(int));
+	return true;
+}
+
+// 체크포인트를 내리지 못하면 더 진행해도 재시작 때 믿을 수 없으므로 그 자리에서 중단
+CheckpointRunStats AbortOnCheckpointError(CheckpointLog& log, CheckpointRunStats& stats,
+	const LARGE_INTEGER& start, const LARGE_INTEGER& freq)
+{
+	stats.ioError = log.GetLastErrorCode();
+	stats.syncCount = log.GetSyncCount();
+	log.Abandon();
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+	stats.totalMs = (double)(now.QuadPart - start.QuadPart) * 1000.0 / freq.QuadPart;
+	std::cerr << "[조정자] 체크포인트를 디스크에 기록하지 못해 배치를 중단합니다. (오류 " << stats.ioError << ")\n";
+	return stats;
+}
+
+// 단계를 순서대로, 단계 안에서는 청크 순서대로 처리하면서 청크마다 체크포인트를 남김
+// logPath가 NULL이면 체크포인트 없이 실행 (오버헤드 비교용)
+// crashAfterSteps >= 0이면 그만큼 처리한 뒤 프로세스가 죽은 것처럼 중단
+CheckpointRunStats RunCheckpointedBatch(const std::vector<PipelineStage>& stages, int chunkCount,
+	const char* logPath, int syncEvery, int crashAfterSteps = -1)
+{
+	CheckpointRunStats stats = {};
+	LARGE_INTEGER freq, start, t0, t1;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&start);
+
+	std::vector<BatchChunk> chunks(chunkCount);
+	std::vector<int> chunkStage(chunkCount, -1);    // 각 청크가 마지막으로 통과한 단계
+	std::vector<bool> stageDone(stages.size(), false);
+	for (int i = 0; i < chunkCount; ++i) {
+		chunks[i].index = i;
+		chunks[i].result = 0;
+	}
+
+	CheckpointLog log;
+	if (logPath) {
+		std::vector<CheckpointLog::Record> records;
+		if (!log.Open(logPath, syncEvery, records)) return stats;
+
+		// 청크마다 가장 뒤 단계의 기록으로 상태를 복원
+		for (const auto& record : records) {
+			if (record.stage >= stages.size()) continue;
+			if (record.chunk == CheckpointLog::kStageDoneChunk) {
+				stageDone[record.stage] = true;
+				continue;
+			}
+			if (record.chunk >= (UINT32)chunkCount || (int)record.stage <= chunkStage[record.chunk]) continue;
+			if (DecodeChunk(record.payload, chunks[record.chunk])) chunkStage[record.chunk] = (int)record.stage;
+		}
+		QueryPerformanceCounter(&t1);
+		stats.recoveryMs = (double)(t1.QuadPart - start.QuadPart) * 1000.0 / freq.QuadPart;
+	}
+
+	std::string payload;
+	for (size_t k = 0; k < stages.size(); ++k) {
+		if (stageDone[k]) {
+			stats.skippedSteps += chunkCount;
+			continue;
+		}
+
+		for (int i = 0; i < chunkCount; ++i) {
+			if (chunkStage[i] >= (int)k) {
+				++stats.skippedSteps;
+				continue;
+			}
+			if (crashAfterSteps >= 0 && stats.executedSteps == crashAfterSteps) {
+				stats.syncCount = log.GetSyncCount();
+				log.Abandon();
+				QueryPerformanceCounter(&t1);
+				stats.totalMs = (double)(t1.QuadPart - start.QuadPart) * 1000.0 / freq.QuadPart;
+				return stats;
+			}
+
+			stages[k].process(chunks[i]);
+			chunkStage[i] = (int)k;
+			++stats.executedSteps;
+
+			if (logPath) {
+				QueryPerformanceCounter(&t0);
+				EncodeChunk(chunks[i], payload);
+				bool durable = log.Append((UINT32)k, (UINT32)i, payload.data(), (UINT32)payload.size());
+				QueryPerformanceCounter(&t1);
+				stats.checkpointMs += (double)(t1.QuadPart - t0.QuadPart) * 1000.0 / freq.QuadPart;
+				if (!durable) return AbortOnCheckpointError(log, stats, start, freq);
+			}
+		}
+
+		// 단계가 끝나면 남은 레코드까지 커밋
+		if (logPath) {
+			QueryPerformanceCounter(&t0);
+			bool durable = log.Append((UINT32)k, CheckpointLog::kStageDoneChunk, nullptr, 0) && log.Sync();
+			QueryPerformanceCounter(&t1);
+			stats.checkpointMs += (double)(t1.QuadPart - t0.QuadPart) * 1000.0 / freq.QuadPart;
+			if (!durable) return AbortOnCheckpointError(log, stats, start, freq);
+		}
+	}
+
+	stats.syncCount = log.GetSyncCount();
+	if (logPath && !log.Close()) return AbortOnCheckpointError(log, stats, start, freq);
+	QueryPerformanceCounter(&t1);
+	stats.totalMs = (double)(t1.QuadPart - start.QuadPart) * 1000.0 / freq.QuadPart;
+	stats.completed = true;
+	for (const auto& chunk : chunks) stats.checksum += chunk.result;
+	return stats;
+}
+
+void PrintCheckpointStats(const char* label, const CheckpointRunStats& stats)
+{
+	std::cout << std::left << std::setw(26) << label << std::right << std::fixed << std::setprecision(1)
+		<< (stats.completed ? " 완료" : " 중단") << " | 전체 " << std::setw(7) << stats.totalMs
+		<< "ms | 복구 " << std::setw(5) << stats.recoveryMs << "ms | 체크포인트 " << std::setw(6) << stats.checkpointMs
+		<< "ms (" << std::setprecision(2) << (stats.totalMs > 0 ? stats.checkpointMs * 100.0 / stats.totalMs : 0.0)
+		<< "%) | 실행 " << stats.executedSteps << " / 건너뜀 " << stats.skippedSteps << " | sync " << stats.syncCount;
+	if (stats.completed) std::cout << " | 검증합 " << stats.checksum;
+	if (stats.ioError != ERROR_SUCCESS) std::cout << " | I/O 오류 " << stats.ioError;
+	std::cout << "\n";
+	std::cout.unsetf(std::ios::fixed);
+}
+
+// 실제로 프로세스를 종료했다가 다시 실행해 볼 수 있는 모드 (완료되면 로그를 지움)
+void RunCheckpointBatch(const char* logPath)
+{
+	const int chunkCount = 10;
+	std::cout << "[조정자] 체크포인트 배치를 시작합니다. (로그: " << logPath << ")\n";
+	std::cout << "[조정자] 도중에 Ctrl+C로 종료한 뒤 같은 명령으로 다시 실행하면 이어서 처리합니다.\n";
+
+	CheckpointRunStats stats = RunCheckpointedBatch(MakeBatchStages(chunkCount, 1, 1, 1), chunkCount, logPath, 4);
+	PrintCheckpointStats("체크포인트 배치", stats);
+	if (stats.ioError != ERROR_SUCCESS) {
+		std::cout << "[조정자] 체크포인트 기록 실패로 중단했습니다. 디스크 상태를 확인한 뒤 다시 실행하세요.\n";
+	}
+	else if (stats.completed) {
+		DeleteFileA(logPath);
+		std::cout << "[조정자] 배치 프로세스가 모두 완료되어 체크포인트를 정리했습니다.\n";
+	}
+}
+
+void BenchmarkCheckpoint()
+{
+	const int chunkCount = 20;
+	const int totalSteps = chunkCount * 3;
+	const char* logPath = "batch_checkpoint_bench.log";
+
+	std::cout << "=== 체크포인트 오버헤드와 복구 (청크 " << chunkCount << "개 x 3단계) ===\n";
+	std::vector<PipelineStage> stages = MakeBatchStages(chunkCount, 1, 1, 1);
+
+	PrintCheckpointStats("체크포인트 없음", RunCheckpointedBatch(stages, chunkCount, NULL, 1));
+
+	DeleteFileA(logPath);
+	PrintCheckpointStats("체크포인트 (매번 sync)", RunCheckpointedBatch(stages, chunkCount, logPath, 1));
+	DeleteFileA(logPath);
+	PrintCheckpointStats("체크포인트 (8개마다 sync)", RunCheckpointedBatch(stages, chunkCount, logPath, 8));
+	DeleteFileA(logPath);
+
+	// B 단계 중간(전체의 60%)에서 죽은 뒤 재시작: 커밋 안 된 레코드만큼은 다시 처리
+	int crashAt = totalSteps * 6 / 10;
+	PrintCheckpointStats("B 도중 중단", RunCheckpointedBatch(stages, chunkCount, logPath, 8, crashAt));
+	PrintCheckpointStats("재시작", RunCheckpointedBatch(stages, chunkCount, logPath, 8));
+	DeleteFileA(logPath);
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc > 1 && strcmp(argv[1], "--bench-dag") == 0) {
+		BenchmarkFanOutFanIn();
+		return 0;
+	}
+	if (argc > 1 && strcmp(argv[1], "--bench-pipeline") == 0) {
+		BenchmarkPipeline();
+		return 0;
+	}
+	if (argc > 1 && strcmp(argv[1], "--bench-checkpoint") == 0) {
+		BenchmarkCheckpoint();
+		return 0;
+	}
+	if (argc > 2 && strcmp(argv[1], "--checkpoint") == 0) {
+		RunCheckpointBatch(argv[2]);
+		return 0;
+	}
 
+	RunEventBatch();
+	RunGraphBatch();
+	RunPipelineBatch();
 	return 0;
 }
 
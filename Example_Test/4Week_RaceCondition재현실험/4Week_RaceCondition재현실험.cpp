@@ -3,33 +3,497 @@
 #include <vector>
 #include <thread>
 #include <iomanip>
+#include <memory>
+#include <cstring>
+#include <cstdlib>
+#include <string>
+
+// ============================================================
+// 경합 탐지 모드 (happens-before 추적기)
+// 최종 잔액이 틀린 것만으로는 어디서 경합이 났는지 알 수 없습니다.
+// --race-detect로 켜면 TrackedLock/TrackedEvent/TrackedSemaphore/TrackedThread가
+// 스레드마다 벡터 시계를 전달하고, RACE_READ/RACE_WRITE로 표시한 변수는 섀도 워드에
+// 마지막 읽기/쓰기 시점(스레드, 시계, 위치, 스택)을 남깁니다. 두 접근 사이에
+// happens-before 관계가 없으면 경합으로 보고합니다.
+// 꺼져 있으면 분기 하나만 추가되고, 켜져 있어도 N번 중 1번만 검사하도록
+// 표본 추출(sampleRate)해 부하 중인 스테이징에서도 돌릴 수 있게 합니다.
+// 동기화 연산은 표본 추출 없이 항상 추적합니다 (놓치면 거짓 경합이 보고됨).
+// ============================================================
+
+// 동시에 이보다 많은 스레드는 추적하지 않음. 새 번호가 바닥나면 TrackedThread가
+// 종료하며 돌려준 번호를 재사용하는데, 재사용한 스레드는 같은 번호의 이전 스레드를
+// 이어서 실행하는 것으로 보므로 그 둘 사이의 경합은 놓칠 수 있음
+const int kMaxRaceThreads = 64;
+const int kRaceStackDepth = 8;
+
+struct VectorClock
+{
+	UINT32 clock[kMaxRaceThreads];
+
+	VectorClock() { memset(clock, 0, sizeof(clock)); }
+
+	// 번호가 붙은 스레드 수(count)까지만 합침
+	void Join(const VectorClock& other, int count = kMaxRaceThreads)
+	{
+		for (int i = 0; i < count; ++i)
+		{
+			if (other.clock[i] > clock[i]) clock[i] = other.clock[i];
+		}
+	}
+};
+
+struct RaceThreadState
+{
+	int tid;
+	DWORD osThreadId;
+	VectorClock vc;
+	UINT32 sampleCounter;
+};
+
+// 섀도 워드에 남기는 접근 기록
+struct RaceAccess
+{
+	int tid;            // -1이면 기록 없음
+	UINT32 clock;
+	DWORD osThreadId;
+	const char* file;
+	int line;
+	USHORT frameCount;
+	void* frames[kRaceStackDepth];
+};
+
+// 추적할 변수 하나에 붙이는 섀도 워드
+struct RaceShadow
+{
+	const char* name;
+	SRWLOCK lock;
+	RaceAccess lastWrite;
+	RaceAccess lastRead;
+	volatile LONG reported;
+
+	explicit RaceShadow(const char* name) : name(name), reported(0)
+	{
+		InitializeSRWLock(&lock);
+		memset(&lastWrite, 0, sizeof(lastWrite));
+		memset(&lastRead, 0, sizeof(lastRead));
+		lastWrite.tid = -1;
+		lastRead.tid = -1;
+	}
+};
+
+class RaceDetector
+{
+private:
+	volatile LONG enabled;
+	LONG sampleRate;
+	LONG maxReportsPerVariable;
+	volatile LONG nextTid;           // tidLock 아래에서만 증가, kMaxRaceThreads에서 멈춤
+	volatile LONG raceCount;
+	volatile LONG printedCount;
+	CRITICAL_SECTION reportLock;
+	SRWLOCK tidLock;
+	std::vector<int> freeTids;       // 종료한 스레드가 돌려준 번호
+	std::vector<std::unique_ptr<RaceThreadState>> threads;
+
+	static thread_local RaceThreadState* t_state;
+	static thread_local bool t_untracked;   // 번호를 받지 못했거나 이미 반납한 스레드
+
+	// 새 번호를 먼저 쓰고, 바닥나면 반납된 번호를 재사용
+	RaceThreadState* Register()
+	{
+		RaceThreadState* state = nullptr;
+		AcquireSRWLockExclusive(&tidLock);
+		if (nextTid < kMaxRaceThreads)
+		{
+			int tid = nextTid;
+			state = new RaceThreadState();
+			state->tid = tid;
+			state->vc.clock[tid] = 1;
+			threads[tid].reset(state);
+			InterlockedExchange(&nextTid, tid + 1);
+		}
+		else if (!freeTids.empty())
+		{
+			// 시계는 그대로 두고 이어서 올림 (이전 스레드가 남긴 기록보다 항상 뒤)
+			state = threads[freeTids.back()].get();
+			freeTids.pop_back();
+			++state->vc.clock[state->tid];
+		}
+		ReleaseSRWLockExclusive(&tidLock);
+
+		if (!state)
+		{
+			t_untracked = true;
+			return nullptr;
+		}
+		state->osThreadId = GetCurrentThreadId();
+		state->sampleCounter = 0;
+		t_state = state;
+		return state;
+	}
+
+	static const char* BaseName(const char* path)
+	{
+		const char* name = path;
+		for (const char* p = path; *p; ++p)
+		{
+			if (*p == '\\' || *p == '/') name = p + 1;
+		}
+		return name;
+	}
+
+	void PrintAccess(const char* label, const RaceAccess& access, bool isWrite)
+	{
+		std::cout << "  " << label << ": 스레드 #" << access.tid << " (OS " << access.osThreadId << ") "
+			<< (isWrite ? "쓰기" : "읽기") << " @ " << BaseName(access.file) << ":" << access.line << "\n";
+		if (access.frameCount == 0) return;
+		std::cout << "    스택:";
+		for (USHORT i = 0; i < access.frameCount; ++i)
+		{
+			std::cout << " 0x" << std::hex << (ULONG_PTR)access.frames[i] << std::dec;
+		}
+		std::cout << "\n";
+	}
+
+	void Report(RaceShadow& shadow, const RaceAccess& previous, bool previousWrite, const RaceAccess& current, bool currentWrite)
+	{
+		InterlockedIncrement(&raceCount);
+		if (InterlockedIncrement(&shadow.reported) > maxReportsPerVariable) return;
+		InterlockedIncrement(&printedCount);
+
+		EnterCriticalSection(&reportLock);
+		std::cout << "[경합] " << shadow.name << ": " << (previousWrite ? "쓰기" : "읽기") << "-"
+			<< (currentWrite ? "쓰기" : "읽기") << " (두 접근 사이에 happens-before 관계 없음)\n";
+		PrintAccess("현재", current, currentWrite);
+		PrintAccess("이전", previous, previousWrite);
+		LeaveCriticalSection(&reportLock);
+	}
+
+	// 현재 접근이 이전 접근 "뒤에" 일어났다고 볼 수 있는지 (이전 시점이 내 벡터 시계에 포함됨)
+	static bool HappensBefore(const RaceAccess& previous, const RaceThreadState& current)
+	{
+		return previous.tid < 0 || previous.tid == current.tid || previous.clock <= current.vc.clock[previous.tid];
+	}
+
+public:
+	RaceDetector() : enabled(0), sampleRate(1), maxReportsPerVariable(3), nextTid(0), raceCount(0), printedCount(0)
+	{
+		InitializeCriticalSection(&reportLock);
+		InitializeSRWLock(&tidLock);
+		threads.resize(kMaxRaceThreads);
+	}
+
+	~RaceDetector() { DeleteCriticalSection(&reportLock); }
+
+	// 스레드를 만들기 전에 호출. sampleRate번 접근 중 1번만 검사
+	void Enable(LONG rate, LONG maxReports = 3)
+	{
+		sampleRate = rate < 1 ? 1 : rate;
+		maxReportsPerVariable = maxReports;
+		InterlockedExchange(&enabled, 1);
+	}
+
+	bool IsEnabled() const { return enabled != 0; }
+	LONG GetRaceCount() const { return raceCount; }
+	LONG GetPrintedCount() const { return printedCount; }
+
+	// 처음 호출한 스레드에 번호를 붙임. 번호가 없으면 nullptr (추적하지 않음)
+	// 실패도 스레드별로 기억하므로 추적하지 않는 스레드가 매번 번호를 요청하지 않음
+	RaceThreadState* Current()
+	{
+		if (t_state || t_untracked) return t_state;
+		return Register();
+	}
+
+	int ActiveThreadCount() const { return (int)nextTid; }
+
+	// 잠금 획득/이벤트 대기 성공: 동기화 객체의 시계를 내 시계에 합침
+	void OnAcquire(const VectorClock& sync)
+	{
+		RaceThreadState* state = Current();
+		if (state) state->vc.Join(sync, ActiveThreadCount());
+	}
+
+	// 잠금 해제/이벤트 신호: 내 시계를 동기화 객체에 남기고 내 시점을 하나 올림
+	void OnRelease(VectorClock& sync, bool overwrite)
+	{
+		RaceThreadState* state = Current();
+		if (!state) return;
+		if (overwrite) sync = state->vc;
+		else sync.Join(state->vc, ActiveThreadCount());
+		++state->vc.clock[state->tid];
+	}
+
+	void Access(RaceShadow& shadow, bool isWrite, const char* file, int line)
+	{
+		RaceThreadState* state = Current();
+		if (!state) return;
+		if (sampleRate > 1 && ++state->sampleCounter % (UINT32)sampleRate != 0) return;
+
+		RaceAccess current;
+		current.tid = state->tid;
+		current.clock = state->vc.clock[state->tid];
+		current.osThreadId = state->osThreadId;
+		current.file = file;
+		current.line = line;
+		current.frameCount = CaptureStackBackTrace(1, kRaceStackDepth, current.frames, NULL);
+
+		RaceAccess previous;
+		bool previousWrite = false;
+		bool racy = false;
+
+		AcquireSRWLockExclusive(&shadow.lock);
+		if (!HappensBefore(shadow.lastWrite, *state))
+		{
+			previous = shadow.lastWrite;
+			previousWrite = true;
+			racy = true;
+		}
+		else if (isWrite && !HappensBefore(shadow.lastRead, *state))
+		{
+			previous = shadow.lastRead;
+			racy = true;
+		}
+		if (isWrite) shadow.lastWrite = current;
+		else shadow.lastRead = current;
+		ReleaseSRWLockExclusive(&shadow.lock);
+
+		if (racy) Report(shadow, previous, previousWrite, current, isWrite);
+	}
+
+	// 스레드 생성: 자식은 부모의 현재 시계에서 출발
+	VectorClock Fork()
+	{
+		VectorClock snapshot;
+		RaceThreadState* state = Current();
+		if (state)
+		{
+			snapshot = state->vc;
+			++state->vc.clock[state->tid];
+		}
+		return snapshot;
+	}
+
+	void Adopt(const VectorClock& parent) { OnAcquire(parent); }
+
+	// 스레드 종료: 마지막 시계를 남기고(join한 쪽이 합침) 번호를 반납
+	// 이후 이 스레드의 접근은 추적하지 않음
+	void Exit(VectorClock& finish)
+	{
+		RaceThreadState* state = Current();
+		if (!state) return;
+		finish = state->vc;
+		t_state = nullptr;
+		t_untracked = true;
+
+		AcquireSRWLockExclusive(&tidLock);
+		freeTids.push_back(state->tid);
+		ReleaseSRWLockExclusive(&tidLock);
+	}
+};
+
+thread_local RaceThreadState* RaceDetector::t_state = nullptr;
+thread_local bool RaceDetector::t_untracked = false;
+
+RaceDetector g_raceDetector;
+
+// 추적할 변수에 접근하기 직전에 표시 (경합 탐지 모드가 꺼져 있으면 분기 하나)
+#define RACE_READ(shadow) do { if (g_raceDetector.IsEnabled()) g_raceDetector.Access((shadow), false, __FILE__, __LINE__); } while (0)
+#define RACE_WRITE(shadow) do { if (g_raceDetector.IsEnabled()) g_raceDetector.Access((shadow), true, __FILE__, __LINE__); } while (0)
+
+class TrackedLock
+{
+private:
+	CRITICAL_SECTION cs;
+	VectorClock vc;
+
+public:
+	TrackedLock() { InitializeCriticalSection(&cs); }
+	~TrackedLock() { DeleteCriticalSection(&cs); }
+
+	void Lock()
+	{
+		EnterCriticalSection(&cs);
+		if (g_raceDetector.IsEnabled()) g_raceDetector.OnAcquire(vc);
+	}
+
+	void Unlock()
+	{
+		if (g_raceDetector.IsEnabled()) g_raceDetector.OnRelease(vc, true);
+		LeaveCriticalSection(&cs);
+	}
+};
+
+class TrackedEvent
+{
+private:
+	HANDLE handle;
+	SRWLOCK vcLock;
+	VectorClock vc;
+
+public:
+	explicit TrackedEvent(bool manualReset) : handle(CreateEvent(NULL, manualReset, FALSE, NULL)) { InitializeSRWLock(&vcLock); }
+	~TrackedEvent() { if (handle) CloseHandle(handle); }
+
+	void Set()
+	{
+		if (g_raceDetector.IsEnabled())
+		{
+			AcquireSRWLockExclusive(&vcLock);
+			g_raceDetector.OnRelease(vc, false);
+			ReleaseSRWLockExclusive(&vcLock);
+		}
+		SetEvent(handle);
+	}
+
+	void Reset() { ResetEvent(handle); }
+
+	DWORD Wait(DWORD timeoutMs = INFINITE)
+	{
+		DWORD result = WaitForSingleObject(handle, timeoutMs);
+		if (result == WAIT_OBJECT_0 && g_raceDetector.IsEnabled())
+		{
+			AcquireSRWLockShared(&vcLock);
+			g_raceDetector.OnAcquire(vc);
+			ReleaseSRWLockShared(&vcLock);
+		}
+		return result;
+	}
+};
+
+class TrackedSemaphore
+{
+private:
+	HANDLE handle;
+	SRWLOCK vcLock;
+	VectorClock vc;
+
+public:
+	TrackedSemaphore(LONG initialCount, LONG maximumCount) : handle(CreateSemaphore(NULL, initialCount, maximumCount, NULL))
+	{
+		InitializeSRWLock(&vcLock);
+	}
+	~TrackedSemaphore() { if (handle) CloseHandle(handle); }
+
+	void Release(LONG count = 1)
+	{
+		if (g_raceDetector.IsEnabled())
+		{
+			AcquireSRWLockExclusive(&vcLock);
+			g_raceDetector.OnRelease(vc, false);
+			ReleaseSRWLockExclusive(&vcLock);
+		}
+		ReleaseSemaphore(handle, count, NULL);
+	}
+
+	DWORD Wait(DWORD timeoutMs = INFINITE)
+	{
+		DWORD result = WaitForSingleObject(handle, timeoutMs);
+		if (result == WAIT_OBJECT_0 && g_raceDetector.IsEnabled())
+		{
+			AcquireSRWLockShared(&vcLock);
+			g_raceDetector.OnAcquire(vc);
+			ReleaseSRWLockShared(&vcLock);
+		}
+		return result;
+	}
+};
+
+// std::thread와 같지만 생성/join을 happens-before 간선으로 기록
+class TrackedThread
+{
+private:
+	VectorClock start;
+	VectorClock finish;
+	std::thread thread;
+
+public:
+	template <typename Function>
+	explicit TrackedThread(Function body)
+	{
+		if (g_raceDetector.IsEnabled()) start = g_raceDetector.Fork();
+		thread = std::thread([this, body]() {
+			if (g_raceDetector.IsEnabled()) g_raceDetector.Adopt(start);
+			body();
+			if (g_raceDetector.IsEnabled()) g_raceDetector.Exit(finish);
+			});
+	}
+
+	TrackedThread(const TrackedThread&) = delete;
+	TrackedThread& operator=(const TrackedThread&) = delete;
+
+	void Join()
+	{
+		thread.join();
+		if (g_raceDetector.IsEnabled()) g_raceDetector.OnAcquire(finish);
+	}
+};
 
 class UnsafeBankAccount
 {
 private:
 	volatile int balance;  // volatile: 컴파일러 최적화 방지
+	RaceShadow balanceShadow;
 
 public:
-	UnsafeBankAccount(int initialBalance = 0) : balance(initialBalance) {}
+	UnsafeBankAccount(int initialBalance = 0) : balance(initialBalance), balanceShadow("UnsafeBankAccount::balance") {}
 
 	void Deposit(int amount) 
 	{
 		// 위험한 연산: 원자성이 보장되지 않음
+		RACE_READ(balanceShadow);
 		int temp = balance;        // 1. 읽기
 		Sleep(1);                  // 2. 컨텍스트 스위치 유발
+		RACE_WRITE(balanceShadow);
 		balance = temp + amount;   // 3. 쓰기
 	}
 
 	void Withdraw(int amount)
 	{
+		RACE_READ(balanceShadow);
 		int temp = balance;
 		Sleep(1);
-		if (temp >= amount) balance = temp - amount;
+		if (temp >= amount)
+		{
+			RACE_WRITE(balanceShadow);
+			balance = temp - amount;
+		}
 	}
 
 	int GetBalance() const { return balance; }
 };
 
+// 같은 연산을 TrackedLock으로 보호한 버전. 경합 탐지 모드에서 보고가 없어야 함
+class SafeBankAccount
+{
+private:
+	int balance;
+	RaceShadow balanceShadow;
+	TrackedLock lock;
+
+public:
+	SafeBankAccount(int initialBalance = 0) : balance(initialBalance), balanceShadow("SafeBankAccount::balance") {}
+
+	void Deposit(int amount)
+	{
+		lock.Lock();
+		RACE_READ(balanceShadow);
+		int temp = balance;
+		RACE_WRITE(balanceShadow);
+		balance = temp + amount;
+		lock.Unlock();
+	}
+
+	int GetBalance()
+	{
+		lock.Lock();
+		RACE_READ(balanceShadow);
+		int value = balance;
+		lock.Unlock();
+		return value;
+	}
+};
+
 void TestRaceCondition()
 {
 	const int THREAD_COUNT = 10;
@@ -37,7 +501,7 @@ void TestRaceCondition()
 	const int DEPOSIT_AMOUNT = 10;
 
 	UnsafeBankAccount account(0);
-	std::vector<std::thread> threads;
+	std::vector<std::unique_ptr<TrackedThread>> threads;
 	
 	std::cout << "=== Race Condition 테스트 시작 ===\n";
 	std::cout << "스레드 수: " << THREAD_COUNT << "\n";
@@ -47,17 +511,17 @@ void TestRaceCondition()
 
 	for (int i = 0; i < THREAD_COUNT; ++i)
 	{
-		threads.emplace_back([&account, OPERATIONS_PER_THREAD, DEPOSIT_AMOUNT, i]() {
+		threads.emplace_back(new TrackedThread([&account, OPERATIONS_PER_THREAD, DEPOSIT_AMOUNT, i]() {
 			for (int j = 0; j < OPERATIONS_PER_THREAD; ++j)
 			{
 				account.Deposit(DEPOSIT_AMOUNT);
 				if (j % 20 == 0) std::cout << "스레드 " << i << ": " << (j + 1) << "회 입금 완료\n";
 			}
-			});
+			}));
 	}
 
 	// 모든 스레드 완료 대기
-	for (auto& t : threads) t.join();
+	for (auto& t : threads) t->Join();
 
 	std::cout << "\n=== 결과 ===\n";
 	std::cout << "실제 최종 잔액: " << account.GetBalance() << "\n";
@@ -70,8 +534,107 @@ void TestRaceCondition()
 		std::cout << "Yes! .... 우연히 정확한 결과 (다시 실행해보세요)\n";
 }
 
-int main()
+// 보호된 계좌에 스레드 여러 개가 입금하고, 이벤트로 "준비 완료"를 알린 뒤 읽음
+// 잠금/이벤트/스레드 join이 모두 happens-before를 만들므로 보고가 없어야 함
+void TestSynchronizedAccess()
+{
+	const int THREAD_COUNT = 4;
+	const int OPERATIONS_PER_THREAD = 1000;
+
+	SafeBankAccount account(0);
+	TrackedEvent ready(true);
+	TrackedSemaphore slots(2, 2);   // 동시에 두 스레드만 입금
+	int summary = 0;
+	RaceShadow summaryShadow("summary");
+	std::vector<std::unique_ptr<TrackedThread>> threads;
+
+	for (int i = 0; i < THREAD_COUNT; ++i)
+	{
+		threads.emplace_back(new TrackedThread([&account, &slots, OPERATIONS_PER_THREAD]() {
+			for (int j = 0; j < OPERATIONS_PER_THREAD; ++j)
+			{
+				slots.Wait();
+				account.Deposit(1);
+				slots.Release();
+			}
+			}));
+	}
+
+	// 요약 값은 잠금 없이 쓰고, 이벤트로 넘겨준 뒤 다른 스레드가 읽음
+	TrackedThread reader([&ready, &summary, &summaryShadow]() {
+		ready.Wait();
+		RACE_READ(summaryShadow);
+		std::cout << "요약 스레드가 읽은 값: " << summary << "\n";
+		});
+
+	for (auto& t : threads) t->Join();
+	RACE_WRITE(summaryShadow);
+	summary = account.GetBalance();
+	ready.Set();
+	reader.Join();
+
+	std::cout << "보호된 계좌 잔액: " << account.GetBalance() << " (예상 " << THREAD_COUNT * OPERATIONS_PER_THREAD << ")\n";
+}
+
+// 탐지기 부하 측정: 보호된 계좌 입금을 꺼짐/표본 비율별로 실행
+void BenchmarkRaceDetector()
+{
+	const int THREAD_COUNT = 4;
+	const int OPERATIONS_PER_THREAD = 200000;
+	const LONG sampleRates[] = { 0, 1, 16, 256 };   // 0: 꺼짐
+
+	std::cout << "=== 경합 탐지기 부하 (스레드 " << THREAD_COUNT << "개 x 입금 " << OPERATIONS_PER_THREAD << "회) ===\n";
+	for (LONG rate : sampleRates)
+	{
+		if (rate > 0) g_raceDetector.Enable(rate);
+		SafeBankAccount account(0);
+		LARGE_INTEGER frequency, start, end;
+		QueryPerformanceFrequency(&frequency);
+		QueryPerformanceCounter(&start);
+
+		std::vector<std::unique_ptr<TrackedThread>> threads;
+		for (int i = 0; i < THREAD_COUNT; ++i)
+		{
+			threads.emplace_back(new TrackedThread([&account, OPERATIONS_PER_THREAD]() {
+				for (int j = 0; j < OPERATIONS_PER_THREAD; ++j) account.Deposit(1);
+				}));
+		}
+		for (auto& t : threads) t->Join();
+		QueryPerformanceCounter(&end);
+
+		double ns = (double)(end.QuadPart - start.QuadPart) * 1e9 / frequency.QuadPart / ((double)THREAD_COUNT * OPERATIONS_PER_THREAD);
+		std::cout << (rate == 0 ? std::string("꺼짐") : "표본 1/" + std::to_string(rate))
+			<< "\t: 입금당 " << std::fixed << std::setprecision(1) << ns << "ns, 잔액 " << account.GetBalance()
+			<< ", 경합 보고 " << g_raceDetector.GetRaceCount() << "\n";
+	}
+}
+
+int main(int argc, char* argv[])
 {
+	if (argc > 1 && strcmp(argv[1], "--race-overhead") == 0)
+	{
+		BenchmarkRaceDetector();
+		return 0;
+	}
+
+	// --race-detect [표본 비율]: 경합 탐지 모드로 실행
+	if (argc > 1 && strcmp(argv[1], "--race-detect") == 0)
+	{
+		LONG rate = argc > 2 ? atol(argv[2]) : 1;
+		g_raceDetector.Enable(rate);
+		std::cout << "경합 탐지 모드 (표본 비율 1/" << (rate < 1 ? 1 : rate) << ")\n\n";
+	}
+
 	TestRaceCondition();
+
+	if (g_raceDetector.IsEnabled())
+	{
+		std::cout << "\n=== 동기화된 접근 (보고가 없어야 함) ===\n";
+		LONG before = g_raceDetector.GetRaceCount();
+		TestSynchronizedAccess();
+		std::cout << "동기화된 접근에서 보고된 경합: " << g_raceDetector.GetRaceCount() - before << "건\n";
+		std::cout << "\n탐지된 경합 총 " << g_raceDetector.GetRaceCount() << "건 (출력 "
+			<< g_raceDetector.GetPrintedCount() << "건, 변수당 최대 3건)\n";
+	}
 	return 0;
-}
\ No newline at end of file
+}
@@ -1,7 +1,10 @@
 ﻿#include <iostream>
 #include <windows.h>
 #include <process.h>
+#include <malloc.h>
+#include <new>
 #include <vector>
+#include <cstring>
 
 int potion_count = 10; // 공유 자원: 물약 10개
 CRITICAL_SECTION cs;     // 크리티컬 섹션
@@ -28,8 +31,240 @@ unsigned int __stdcall usePotion(void* arg)
 	return 0;
 }
 
-int main()
+// ------------------------------------------------------------
+// 소모품 인벤토리 서비스
+// usePotion은 Sleep(10)과 printf까지 크리티컬 섹션 안에서 해서 플레이어 20명이 한 줄로
+// 섭니다. 재고 감소만 원자적으로 "예약"하고, 마시는 연출 같은 느린 작업은 잠금 없이
+// 한 뒤 "확정"(또는 취소해 반납)합니다. 재고는 샤드로 나눠 스레드마다 자기 샤드부터
+// CAS로 꺼내고, 비었으면 다른 샤드에서 가져옵니다. CAS는 재고가 충분할 때만
+// 성공하므로 재고는 절대 0 아래로 내려가지 않습니다.
+// ------------------------------------------------------------
+
+struct PotionReservation
+{
+	int shard;      // -1이면 예약 실패 (재고 없음)
+	LONG amount;
+};
+
+class ConsumableInventory
+{
+private:
+	// 샤드끼리 같은 캐시 라인을 쓰지 않도록 64바이트 정렬 (sizeof도 64가 됨)
+	struct __declspec(align(64)) Shard
+	{
+		volatile LONG stock;
+	};
+
+	// std::vector는 64바이트 정렬을 보장하지 않으므로 정렬된 블록을 직접 잡음
+	Shard* shards;
+	int shardCount;
+	volatile LONG committed;
+
+	bool TryTake(Shard& shard, LONG amount)
+	{
+		LONG current = shard.stock;
+		while (current >= amount)
+		{
+			LONG previous = InterlockedCompareExchange(&shard.stock, current - amount, current);
+			if (previous == current) return true;
+			current = previous;
+		}
+		return false;
+	}
+
+public:
+	ConsumableInventory(LONG initialStock, int requestedShards)
+		: shards(nullptr), shardCount(requestedShards < 1 ? 1 : requestedShards), committed(0)
+	{
+		shards = (Shard*)_aligned_malloc(shardCount * sizeof(Shard), 64);
+		if (shards == nullptr) throw std::bad_alloc();
+		memset(shards, 0, shardCount * sizeof(Shard));
+		Restock(initialStock);
+	}
+
+	~ConsumableInventory() { _aligned_free(shards); }
+
+	ConsumableInventory(const ConsumableInventory&) = delete;
+	ConsumableInventory& operator=(const ConsumableInventory&) = delete;
+
+	// 재고를 샤드에 고르게 나눠 채움
+	void Restock(LONG amount)
+	{
+		LONG count = shardCount;
+		for (LONG i = 0; i < count; ++i)
+		{
+			LONG share = amount / count + (i < amount % count ? 1 : 0);
+			if (share > 0) InterlockedExchangeAdd(&shards[i].stock, share);
+		}
+	}
+
+	// 자기 샤드(hint)부터 시도하고 모자라면 다른 샤드를 차례로 확인
+	// 예약은 한 샤드에서만 꺼내므로 amount가 크면 전체 재고가 있어도 실패할 수 있음
+	PotionReservation Reserve(int hint, LONG amount = 1)
+	{
+		int count = shardCount;
+		int start = (hint % count + count) % count;
+		for (int i = 0; i < count; ++i)
+		{
+			int index = (start + i) % count;
+			if (TryTake(shards[index], amount)) return { index, amount };
+		}
+		return { -1, 0 };
+	}
+
+	// 사용 확정. 재고는 예약 때 이미 줄었으므로 통계만 갱신
+	void Commit(const PotionReservation& reservation)
+	{
+		if (reservation.shard >= 0) InterlockedExchangeAdd(&committed, reservation.amount);
+	}
+
+	// 사용하지 못했으면 (예: 마시다 쓰러짐) 꺼낸 샤드에 반납
+	void Cancel(const PotionReservation& reservation)
+	{
+		if (reservation.shard >= 0) InterlockedExchangeAdd(&shards[reservation.shard].stock, reservation.amount);
+	}
+
+	// 동시 변경 중에는 근사값
+	LONG GetStock() const
+	{
+		LONG total = 0;
+		for (int i = 0; i < shardCount; ++i) total += shards[i].stock;
+		return total;
+	}
+
+	LONG GetCommitted() const { return committed; }
+
+	bool HasNegativeShard() const
+	{
+		for (int i = 0; i < shardCount; ++i)
+		{
+			if (shards[i].stock < 0) return true;
+		}
+		return false;
+	}
+};
+
+// ------------------------------------------------------------
+// 벤치마크: 스레드 1~64개의 초당 소비 횟수
+// ------------------------------------------------------------
+
+enum PotionBenchMode
+{
+	kPotionCriticalSection,   // 원래 방식: 재고 확인~연출까지 잠금 안에서
+	kPotionSingleCounter,     // 카운터 하나에 CAS 예약, 연출은 잠금 밖
+	kPotionSharded            // 샤드별 CAS 예약, 연출은 잠금 밖
+};
+
+struct PotionBenchParam
+{
+	PotionBenchMode mode;
+	int threadIndex;
+	ConsumableInventory* inventory;
+	CRITICAL_SECTION* lock;
+	volatile LONG* lockedStock;
+	LONG consumed;
+};
+
+// 물약을 마시는 연출을 흉내 내는 짧은 계산 (Sleep(10)은 벤치마크가 잠만 재게 되므로)
+inline unsigned DrinkWork(unsigned seed)
+{
+	for (int i = 0; i < 200; ++i) seed = seed * 1103515245u + 12345u;
+	return seed;
+}
+
+volatile unsigned g_drinkSink = 0;
+
+unsigned int __stdcall PotionBenchThread(void* arg)
+{
+	PotionBenchParam* param = (PotionBenchParam*)arg;
+	unsigned seed = (unsigned)param->threadIndex;
+
+	for (;;)
+	{
+		if (param->mode == kPotionCriticalSection)
+		{
+			EnterCriticalSection(param->lock);
+			bool available = *param->lockedStock > 0;
+			if (available)
+			{
+				seed = DrinkWork(seed);
+				--*param->lockedStock;
+			}
+			LeaveCriticalSection(param->lock);
+			if (!available) break;
+		}
+		else
+		{
+			PotionReservation reservation = param->inventory->Reserve(param->threadIndex);
+			if (reservation.shard < 0) break;
+			seed = DrinkWork(seed);
+			param->inventory->Commit(reservation);
+		}
+		++param->consumed;
+	}
+	g_drinkSink += seed;
+	return 0;
+}
+
+double RunPotionBench(PotionBenchMode mode, int threadCount, LONG stock)
+{
+	ConsumableInventory inventory(stock, mode == kPotionSharded ? threadCount : 1);
+	CRITICAL_SECTION lock;
+	InitializeCriticalSection(&lock);
+	volatile LONG lockedStock = stock;
+
+	std::vector<PotionBenchParam> params(threadCount);
+	std::vector<HANDLE> threads;
+	LARGE_INTEGER frequency, start, end;
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&start);
+	for (int i = 0; i < threadCount; ++i)
+	{
+		params[i] = { mode, i, &inventory, &lock, &lockedStock, 0 };
+		HANDLE hThread = (HANDLE)_beginthreadex(NULL, 0, PotionBenchThread, &params[i], 0, NULL);
+		if (hThread) threads.push_back(hThread);
+	}
+	WaitForMultipleObjects((DWORD)threads.size(), threads.data(), TRUE, INFINITE);
+	QueryPerformanceCounter(&end);
+	for (HANDLE hThread : threads) CloseHandle(hThread);
+	DeleteCriticalSection(&lock);
+
+	LONG consumed = 0;
+	for (const PotionBenchParam& param : params) consumed += param.consumed;
+	LONG remaining = mode == kPotionCriticalSection ? lockedStock : inventory.GetStock();
+	if (consumed != stock || remaining != 0 || inventory.HasNegativeShard())
+	{
+		printf("  [오류] 소비 %ld, 남은 재고 %ld (초기 %ld)\n", consumed, remaining, stock);
+	}
+
+	double elapsed = (double)(end.QuadPart - start.QuadPart) / frequency.QuadPart;
+	return consumed / elapsed;
+}
+
+void BenchmarkPotionInventory()
 {
+	const LONG stock = 2000000;
+	const int threadCounts[] = { 1, 2, 4, 8, 16, 32, 64 };
+
+	printf("=== 물약 %ld개 소비, 초당 소비 횟수 ===\n", stock);
+	printf("스레드  크리티컬섹션    CAS 카운터      샤드 CAS\n");
+	for (int threadCount : threadCounts)
+	{
+		double locked = RunPotionBench(kPotionCriticalSection, threadCount, stock);
+		double single = RunPotionBench(kPotionSingleCounter, threadCount, stock);
+		double sharded = RunPotionBench(kPotionSharded, threadCount, stock);
+		printf("%6d  %14.0f  %14.0f  %14.0f\n", threadCount, locked, single, sharded);
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc > 1 && strcmp(argv[1], "--bench-potion") == 0)
+	{
+		BenchmarkPotionInventory();
+		return 0;
+	}
+
 	const int NUM_PLAYERS = 20;
 	std::vector<HANDLE> threads;
 	std::vector<int> playerIds(21,0);
@@ -1,8 +1,69 @@
 ﻿#include <iostream>
 #include <windows.h>
 #include <process.h>
+#include <vector>
+#include <algorithm>
+#include <cstring>
 
-HANDLE g_hBossReadyEvent; // 보스 준비 완료 이벤트
+#pragma comment(lib, "Synchronization.lib") // WaitOnAddress / WakeByAddressAll
+
+// ------------------------------------------------------------
+// 한 번만 열리는 방송형 래치
+// 자동 리셋 이벤트는 SetEvent 한 번에 대기자 하나만 깨우고, 수천 명이 커널 이벤트
+// 하나를 기다리면 모두가 커널 대기 경로를 탑니다. BroadcastLatch는 열린 뒤에는
+// 플래그만 읽고 통과하므로 시스템 호출이 없고, 열 때는 WakeByAddressAll 한 번으로
+// 기다리던 스레드를 모두 깨웁니다. 기다리는 스레드가 없으면 깨우기 호출도 생략합니다.
+// ------------------------------------------------------------
+class BroadcastLatch {
+private:
+	volatile LONG released;
+	volatile LONG sleepers;   // WaitOnAddress에 들어갔거나 들어가려는 스레드 수
+
+public:
+	BroadcastLatch() : released(0), sleepers(0) {}
+
+	bool IsReleased() const { return released != 0; }
+
+	// 열린 뒤에 호출하면 아무 일도 하지 않음
+	void Release() {
+		if (InterlockedExchange(&released, 1) != 0) return;
+		// sleepers를 늘린 뒤 released를 다시 확인하고 잠드는 쪽과 짝이 맞아 깨움을 놓치지 않음
+		if (sleepers != 0) WakeByAddressAll((PVOID)&released);
+	}
+
+	// timeoutMs 안에 열리면 true
+	bool Wait(DWORD timeoutMs = INFINITE) {
+		if (released) return true;
+
+		// 곧 열리는 경우를 위해 잠깐 회전한 뒤 잠듦
+		for (int spin = 0; spin < 200; ++spin) {
+			YieldProcessor();
+			if (released) return true;
+		}
+
+		DWORD start = GetTickCount();
+		InterlockedIncrement(&sleepers);
+		LONG closed = 0;
+		bool opened = true;
+		while (released == 0) {
+			DWORD waitMs = INFINITE;
+			if (timeoutMs != INFINITE) {
+				DWORD elapsed = GetTickCount() - start;
+				if (elapsed >= timeoutMs) {
+					opened = false;
+					break;
+				}
+				waitMs = timeoutMs - elapsed;
+			}
+			// 값이 여전히 0일 때만 잠듦. 그 사이 열렸다면 바로 반환됨
+			WaitOnAddress(&released, &closed, sizeof(LONG), waitMs);
+		}
+		InterlockedDecrement(&sleepers);
+		return opened;
+	}
+};
+
+BroadcastLatch g_bossReady; // 보스 준비 완료 래치
 
 // 보스 몬스터를 로딩하는 스레드 함수
 unsigned int __stdcall loadBoss(void* arg) {
@@ -10,9 +71,8 @@ unsigned int __stdcall loadBoss(void* arg) {
 	Sleep(3000); // 3초 동안 로딩
 	printf("보스 로딩 완료!\n");
 
-	// TODO: 보스 준비 완료 이벤트를 Set 상태로 만드세요.
-	// ...
-	SetEvent(g_hBossReadyEvent);
+	// 기다리는 플레이어 전원을 한 번에 깨움
+	g_bossReady.Release();
 
 	return 0;
 }
@@ -22,24 +82,108 @@ unsigned int __stdcall enterBattle(void* arg) {
 	int playerId = *(int*)arg;
 	printf("Player %d, 보스 로딩을 기다리는 중...\n", playerId);
 
-	// TODO: 보스 준비 완료 이벤트가 Set 상태가 될 때까지 기다리세요.
-	// ...
-	if (WaitForSingleObject(g_hBossReadyEvent, INFINITE) != WAIT_OBJECT_0) return false;
+	// 보스 준비가 끝날 때까지 대기 (이미 끝났다면 바로 통과)
+	if (!g_bossReady.Wait()) return 1;
 
 	printf("Player %d, 전투 시작!\n", playerId);
 	return 0;
 }
 
-int main()
-{
-	// TODO: Manual-reset, non-signaled 상태의 이벤트를 생성하세요.
-	// g_hBossReadyEvent = CreateEvent(...);
+// ------------------------------------------------------------
+// 벤치마크: 해제 시점부터 마지막 대기자가 실행될 때까지
+// ------------------------------------------------------------
+
+struct LatchBenchShared {
+	BroadcastLatch* latch;
+	HANDLE event;               // 비교용 수동 리셋 이벤트 (latch가 nullptr일 때)
+	volatile LONG arrived;
+	std::vector<LONGLONG> wokeAt;
+};
+
+struct LatchBenchParam {
+	LatchBenchShared* shared;
+	int index;
+};
+
+unsigned int __stdcall latchBenchWaiter(void* arg) {
+	LatchBenchParam* param = (LatchBenchParam*)arg;
+	LatchBenchShared* shared = param->shared;
+	InterlockedIncrement(&shared->arrived);
+
+	if (shared->latch) shared->latch->Wait();
+	else WaitForSingleObject(shared->event, INFINITE);
+
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+	shared->wokeAt[param->index] = now.QuadPart;
+	return 0;
+}
+
+// 모든 대기자가 잠든 뒤 해제하고, 마지막 대기자가 깨어난 시각까지의 시간(ms)을 반환
+double runLatchBench(bool useLatch, int waiterCount, double* medianMs) {
+	BroadcastLatch latch;
+	LatchBenchShared shared;
+	shared.latch = useLatch ? &latch : nullptr;
+	shared.event = useLatch ? NULL : CreateEvent(NULL, TRUE, FALSE, NULL);
+	shared.arrived = 0;
+	shared.wokeAt.assign(waiterCount, 0);
+
+	std::vector<LatchBenchParam> params(waiterCount);
+	std::vector<HANDLE> threads;
+	for (int i = 0; i < waiterCount; ++i) {
+		params[i] = { &shared, i };
+		// 대기자가 많으므로 스택은 64KB만 예약
+		HANDLE hThread = (HANDLE)_beginthreadex(NULL, 64 * 1024, latchBenchWaiter, &params[i],
+			STACK_SIZE_PARAM_IS_A_RESERVATION, NULL);
+		if (hThread) threads.push_back(hThread);
+	}
+
+	while (shared.arrived < (LONG)threads.size()) Sleep(1);
+	Sleep(200); // 회전 구간을 지나 모두 잠들 시간
+
+	LARGE_INTEGER frequency, release;
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&release);
+	if (useLatch) latch.Release();
+	else SetEvent(shared.event);
+
+	for (size_t i = 0; i < threads.size(); i += MAXIMUM_WAIT_OBJECTS) {
+		DWORD count = (DWORD)(threads.size() - i < MAXIMUM_WAIT_OBJECTS ? threads.size() - i : MAXIMUM_WAIT_OBJECTS);
+		WaitForMultipleObjects(count, &threads[i], TRUE, INFINITE);
+	}
+	for (HANDLE hThread : threads) CloseHandle(hThread);
+	if (shared.event) CloseHandle(shared.event);
+
+	std::vector<double> delays;
+	for (size_t i = 0; i < shared.wokeAt.size(); ++i) {
+		if (shared.wokeAt[i] == 0) continue;   // 생성에 실패한 스레드
+		delays.push_back((double)(shared.wokeAt[i] - release.QuadPart) * 1000.0 / frequency.QuadPart);
+	}
+	if (delays.empty()) return 0.0;
+	std::nth_element(delays.begin(), delays.begin() + delays.size() / 2, delays.end());
+	*medianMs = delays[delays.size() / 2];
+	double lastMs = 0.0;
+	for (double delay : delays) lastMs = delay > lastMs ? delay : lastMs;
+	return lastMs;
+}
 
-	g_hBossReadyEvent = CreateEvent(NULL, FALSE,FALSE, NULL);
+void benchmarkLatch() {
+	const int waiterCounts[] = { 100, 1000, 10000 };
+	printf("=== 해제 ~ 대기자 실행 지연 (중간값 / 마지막) ===\n");
+	for (int waiterCount : waiterCounts) {
+		double eventMedian = 0.0, latchMedian = 0.0;
+		double eventLast = runLatchBench(false, waiterCount, &eventMedian);
+		double latchLast = runLatchBench(true, waiterCount, &latchMedian);
+		printf("대기자 %5d명 | 수동 리셋 이벤트 %8.3fms / %8.3fms | 래치 %8.3fms / %8.3fms\n",
+			waiterCount, eventMedian, eventLast, latchMedian, latchLast);
+	}
+}
 
-	if (g_hBossReadyEvent == NULL) {
-		printf("이벤트 생성 실패\n");
-		return 1;
+int main(int argc, char* argv[])
+{
+	if (argc > 1 && strcmp(argv[1], "--bench-latch") == 0) {
+		benchmarkLatch();
+		return 0;
 	}
 
 	HANDLE hBossThread = (HANDLE)_beginthreadex(NULL, 0, loadBoss, NULL, 0, NULL);
@@ -59,9 +203,5 @@ int main()
 	for (int i = 0; i < NUM_PLAYERS; ++i) {
 		CloseHandle(hPlayerThreads[i]);
 	}
-	// TODO: 생성한 이벤트를 닫으세요.
-	// ...
-	CloseHandle(g_hBossReadyEvent);
-
 	return 0;
 }
\ No newline at end of file
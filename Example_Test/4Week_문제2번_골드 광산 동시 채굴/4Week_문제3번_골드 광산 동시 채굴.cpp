@@ -1,7 +1,10 @@
 ﻿#include <iostream>
 #include <windows.h>
 #include <process.h>
+#include <malloc.h>
+#include <new>
 #include <vector>
+#include <cstring>
 
 #define NUM_MINERS 5
 #define GOLD_PER_TRIAL 10
@@ -37,8 +40,233 @@ unsigned int __stdcall mineGold(void* arg) {
 	return 0;
 }
 
-int main()
+// ------------------------------------------------------------
+// 스레드별 누적 + 합산(reduction)
+// 증가마다 cs_gold를 잡으면 광부들이 한 줄로 서고, InterlockedAdd도 캐시 라인 하나를
+// 모든 코어가 주고받습니다. GoldReduction은 광부마다 64바이트로 떨어진 슬롯을 주고,
+// 광부는 자기 레지스터/지역 변수에 더하기만 합니다. 합계는 join 뒤 슬롯을 더해
+// 구하거나(Total), 실행 중에는 에폭 스냅샷(Snapshot)으로 구합니다.
+//   Snapshot: 요청 에폭을 올림 -> 각 광부는 다음 Add에서 이를 보고 자기 누적값을
+//   게시하며 에폭을 응답 -> 모든 슬롯이 응답하면 합산. 게시된 값은 그 광부가
+//   응답 시점까지 더한 정확한 값이므로 합계에 빠지거나 두 번 세는 몫이 없습니다.
+// ------------------------------------------------------------
+class GoldReduction {
+private:
+	// 광부마다 캐시 라인 하나 (64바이트 정렬이라 sizeof도 64)
+	struct __declspec(align(64)) Slot {
+		volatile LONGLONG value;    // 마지막으로 게시된 누적값
+		volatile LONG epoch;        // 마지막으로 응답한 에폭 (은퇴하면 MAXLONG)
+	};
+
+	// std::vector는 64바이트 정렬을 보장하지 않으므로 정렬된 블록을 직접 잡음
+	Slot* slots;
+	LONG capacity;
+	volatile LONG slotCount;
+	volatile LONG requestedEpoch;
+
+public:
+	// 광부 스레드 하나가 쥐는 누적기. Add는 지역 변수에만 더하고,
+	// 스냅샷 요청이 있을 때만 슬롯에 게시함
+	class Accumulator {
+	private:
+		GoldReduction* owner;
+		Slot* slot;
+		LONGLONG local;
+		LONG seenEpoch;
+
+		void Publish(LONG epoch) {
+			InterlockedExchange64(&slot->value, local);
+			InterlockedExchange(&slot->epoch, epoch); // 값 게시 뒤에 응답
+			seenEpoch = epoch;
+		}
+
+	public:
+		Accumulator(GoldReduction* owner, Slot* slot) : owner(owner), slot(slot), local(0), seenEpoch(0) {}
+
+		void Add(LONGLONG amount) {
+			local += amount;
+			Poll();
+		}
+
+		// 오래 Add를 하지 않는 광부는 주기적으로 불러 스냅샷이 기다리지 않게 함
+		void Poll() {
+			LONG epoch = owner->requestedEpoch;
+			if (epoch != seenEpoch) Publish(epoch);
+		}
+
+		// 작업을 마치면 최종값을 게시하고 이후 스냅샷에서 기다리지 않게 함
+		void Retire() { Publish(MAXLONG); }
+	};
+
+	explicit GoldReduction(int maxWorkers) : slots(nullptr), capacity(maxWorkers < 1 ? 1 : maxWorkers), slotCount(0), requestedEpoch(0) {
+		slots = (Slot*)_aligned_malloc(capacity * sizeof(Slot), 64);
+		if (slots == nullptr) throw std::bad_alloc();
+		memset(slots, 0, capacity * sizeof(Slot));
+	}
+
+	~GoldReduction() { _aligned_free(slots); }
+
+	GoldReduction(const GoldReduction&) = delete;
+	GoldReduction& operator=(const GoldReduction&) = delete;
+
+	// 슬롯을 다 쓰면 false. 만든 누적기는 그 스레드만 사용해야 함
+	bool Register(Accumulator* out) {
+		LONG index = InterlockedIncrement(&slotCount) - 1;
+		if (index >= capacity) {
+			InterlockedDecrement(&slotCount);
+			return false;
+		}
+		slots[index].epoch = requestedEpoch;
+		*out = Accumulator(this, &slots[index]);
+		return true;
+	}
+
+	// 모든 광부가 Retire한 뒤(또는 join 뒤)의 정확한 합계
+	LONGLONG Total() const {
+		LONGLONG total = 0;
+		for (LONG i = 0; i < slotCount; ++i) total += slots[i].value;
+		return total;
+	}
+
+	// 실행 중 정확한 합계. 등록된 광부가 모두 새 에폭에 응답할 때까지 기다림
+	LONGLONG Snapshot() {
+		LONG epoch = InterlockedIncrement(&requestedEpoch);
+		LONG count = slotCount;
+		LONGLONG total = 0;
+		for (LONG i = 0; i < count; ++i) {
+			while (slots[i].epoch < epoch) Sleep(0);
+			total += slots[i].value;
+		}
+		return total;
+	}
+};
+
+// ------------------------------------------------------------
+// 벤치마크: 광부 64명 x 100만 번 증가
+// ------------------------------------------------------------
+#define BENCH_MINERS 64
+#define BENCH_INCREMENTS 1000000
+
+enum GoldBenchMode {
+	kGoldCriticalSection,
+	kGoldInterlocked,
+	kGoldReduction
+};
+
+struct GoldBenchParam {
+	GoldBenchMode mode;
+	GoldReduction* reduction;
+	volatile LONGLONG* sharedGold;
+	CRITICAL_SECTION* lock;
+	HANDLE startEvent;
+};
+
+unsigned int __stdcall benchMiner(void* arg) {
+	GoldBenchParam* param = (GoldBenchParam*)arg;
+	WaitForSingleObject(param->startEvent, INFINITE);
+
+	if (param->mode == kGoldCriticalSection) {
+		for (int i = 0; i < BENCH_INCREMENTS; ++i) {
+			EnterCriticalSection(param->lock);
+			*param->sharedGold += GOLD_PER_TRIAL;
+			LeaveCriticalSection(param->lock);
+		}
+	}
+	else if (param->mode == kGoldInterlocked) {
+		for (int i = 0; i < BENCH_INCREMENTS; ++i) {
+			InterlockedExchangeAdd64(param->sharedGold, GOLD_PER_TRIAL);
+		}
+	}
+	else {
+		GoldReduction::Accumulator accumulator(nullptr, nullptr);
+		if (!param->reduction->Register(&accumulator)) return 1;
+		for (int i = 0; i < BENCH_INCREMENTS; ++i) {
+			accumulator.Add(GOLD_PER_TRIAL);
+		}
+		accumulator.Retire();
+	}
+	return 0;
+}
+
+struct SnapshotParam {
+	GoldReduction* reduction;
+	volatile bool* stop;
+	int snapshots;
+	bool monotonic;
+};
+
+// 채굴 중에 1ms마다 스냅샷을 찍어 합계가 줄어들지 않는지 확인
+unsigned int __stdcall snapshotReader(void* arg) {
+	SnapshotParam* param = (SnapshotParam*)arg;
+	LONGLONG previous = 0;
+	while (!*param->stop) {
+		LONGLONG total = param->reduction->Snapshot();
+		if (total < previous) param->monotonic = false;
+		previous = total;
+		++param->snapshots;
+		Sleep(1);
+	}
+	return 0;
+}
+
+void runGoldBench(const char* label, GoldBenchMode mode) {
+	GoldReduction reduction(BENCH_MINERS);
+	volatile LONGLONG sharedGold = 0;
+	CRITICAL_SECTION lock;
+	InitializeCriticalSection(&lock);
+	HANDLE startEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+	GoldBenchParam param = { mode, &reduction, &sharedGold, &lock, startEvent };
+
+	std::vector<HANDLE> threads;
+	for (int i = 0; i < BENCH_MINERS; ++i) {
+		HANDLE hThread = (HANDLE)_beginthreadex(NULL, 0, benchMiner, &param, 0, NULL);
+		if (hThread) threads.push_back(hThread);
+	}
+
+	volatile bool stop = false;
+	SnapshotParam snapshot = { &reduction, &stop, 0, true };
+	HANDLE hReader = NULL;
+	if (mode == kGoldReduction) hReader = (HANDLE)_beginthreadex(NULL, 0, snapshotReader, &snapshot, 0, NULL);
+
+	LARGE_INTEGER frequency, start, end;
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&start);
+	SetEvent(startEvent);
+	WaitForMultipleObjects((DWORD)threads.size(), threads.data(), TRUE, INFINITE);
+	QueryPerformanceCounter(&end);
+
+	if (hReader) {
+		stop = true;
+		WaitForSingleObject(hReader, INFINITE);
+		CloseHandle(hReader);
+	}
+	for (HANDLE h : threads) CloseHandle(h);
+	CloseHandle(startEvent);
+	DeleteCriticalSection(&lock);
+
+	LONGLONG total = mode == kGoldReduction ? reduction.Total() : sharedGold;
+	LONGLONG expected = (LONGLONG)threads.size() * BENCH_INCREMENTS * GOLD_PER_TRIAL;
+	double elapsed = (double)(end.QuadPart - start.QuadPart) / frequency.QuadPart;
+	printf("%s: %8.3f초, %12.0f 증가/초, 합계 %lld (%s)", label, elapsed,
+		threads.size() * (double)BENCH_INCREMENTS / elapsed, total, total == expected ? "정확" : "불일치");
+	if (hReader) printf(", 실행 중 스냅샷 %d회 (%s)", snapshot.snapshots, snapshot.monotonic ? "단조 증가" : "감소 발생");
+	printf("\n");
+}
+
+void benchmarkGoldReduction() {
+	printf("=== 광부 %d명 x %d번 증가 ===\n", BENCH_MINERS, BENCH_INCREMENTS);
+	runGoldBench("크리티컬 섹션    ", kGoldCriticalSection);
+	runGoldBench("InterlockedAdd64 ", kGoldInterlocked);
+	runGoldBench("스레드별 합산    ", kGoldReduction);
+}
+
+int main(int argc, char* argv[])
 {
+	if (argc > 1 && strcmp(argv[1], "--bench-reduction") == 0) {
+		benchmarkGoldReduction();
+		return 0;
+	}
+
 	// TODO 3: main 함수 시작 시, 크리티컬 섹션을 초기화하세요.
 	// ...
 	InitializeCriticalSection(&cs_gold);
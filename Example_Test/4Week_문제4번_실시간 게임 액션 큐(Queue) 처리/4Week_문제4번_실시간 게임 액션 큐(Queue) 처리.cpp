@@ -2,17 +2,397 @@
 #include <windows.h>
 #include <process.h>
 #include <vector>
+#include <memory>
+#include <algorithm>
+#include <cstring>
 
-#define MAX_QUEUE_SIZE 8
+#pragma comment(lib, "Synchronization.lib") // WaitOnAddress / WakeByAddress
+
+#define MAX_QUEUE_SIZE 8 // 2의 거듭제곱이어야 함
 #define NUM_UNITS 3      // 생산자 스레드 수
 #define NUM_ACTIONS 7    // 각 유닛이 생성할 액션 수
 
+// ------------------------------------------------------------
+// 유한 MPSC 액션 큐
+// 예전 방식은 큐가 차면 생산자가 Sleep(100) 뒤 재시도하고, 엔진은 액션이 쌓여 있어도
+// Sleep(50)마다 하나씩만 꺼내 최대 150ms의 지연이 생겼습니다.
+// ActionQueue는 칸마다 순번(sequence)을 둔 링 버퍼로, 생산자는 CAS 한 번으로 칸을
+// 잡고 잠금 없이 씁니다. 엔진(소비자 하나)은 깨어날 때마다 쌓인 액션을 전부 꺼내고,
+// 큐가 비었을 때만 소비자가, 가득 찼을 때만 생산자가 WaitOnAddress로 잠듭니다.
+// ------------------------------------------------------------
+struct ActionItem {
+	int action;
+	LONGLONG enqueueQpc; // 등록 시각 (등록 ~ 처리 지연 측정용)
+	int unitId;
+	int kind;            // 같은 유닛의 같은 종류 액션끼리 합칠 수 있음
+	int coalesceKey;     // 0이면 일반 항목, 아니면 합치기 슬롯 번호 + 1 (PriorityActionQueue 내부용)
+};
+
+class ActionQueue {
+private:
+	struct Cell {
+		volatile LONG sequence; // pos면 빈 칸, pos + 1이면 pos번째 항목이 들어 있음
+		ActionItem item;
+	};
+
+	std::vector<Cell> cells;
+	LONG mask;
+	volatile LONG enqueuePos;   // 생산자들이 CAS로 경쟁
+	LONG dequeuePos;            // 소비자 하나만 사용
+
+	volatile LONG pushSignal;       // 소비자가 잠드는 주소
+	volatile LONG consumerWaiting;
+	volatile LONG popSignal;        // 가득 차서 생산자들이 잠드는 주소
+	volatile LONG fullWaiters;
+	volatile LONG closed;
+
+	bool TryPushOnce(const ActionItem& item) {
+		for (;;) {
+			LONG pos = enqueuePos;
+			Cell& cell = cells[pos & mask];
+			LONG diff = (LONG)((ULONG)cell.sequence - (ULONG)pos); // 순번이 한 바퀴 돌아도 차이는 올바름
+			if (diff == 0) {
+				LONG next = (LONG)((ULONG)pos + 1);
+				if (InterlockedCompareExchange(&enqueuePos, next, pos) != pos) continue;
+				cell.item = item;
+				// 전체 장벽으로 공개한 뒤 consumerWaiting을 읽음 (깨움 누락 방지)
+				InterlockedExchange(&cell.sequence, next);
+				return true;
+			}
+			if (diff < 0) return false; // 가득 참
+			// 다른 생산자가 이 칸을 먼저 잡음. 위치를 다시 읽음
+		}
+	}
+
+	void WakeConsumer() {
+		if (consumerWaiting && InterlockedExchange(&consumerWaiting, 0) != 0) {
+			InterlockedIncrement(&pushSignal);
+			WakeByAddressSingle((PVOID)&pushSignal);
+		}
+	}
+
+public:
+	explicit ActionQueue(LONG capacity) : enqueuePos(0), dequeuePos(0), pushSignal(0), consumerWaiting(0),
+		popSignal(0), fullWaiters(0), closed(0) {
+		LONG size = 2;
+		while (size < capacity) size <<= 1;
+		cells.resize(size);
+		mask = size - 1;
+		for (LONG i = 0; i < size; ++i) cells[i].sequence = i;
+	}
+
+	LONG Capacity() const { return (LONG)cells.size(); }
+
+	// 동시 변경 중에는 근사값
+	LONG ApproxSize() const {
+		LONG size = (LONG)((ULONG)enqueuePos - (ULONG)dequeuePos);
+		return size < 0 ? 0 : size;
+	}
+
+	// 가득 찼으면 false (기다리지 않음)
+	bool TryPush(const ActionItem& item) {
+		if (!TryPushOnce(item)) return false;
+		WakeConsumer();
+		return true;
+	}
+
+	// 자리가 날 때까지 기다려 넣음. 기다렸다면 *waited = true. 닫힌 큐면 false
+	bool Push(const ActionItem& item, bool* waited = nullptr) {
+		if (waited) *waited = false;
+		while (!closed) {
+			LONG signal = popSignal;
+			if (TryPush(item)) return true;
+			if (waited) *waited = true;
+
+			InterlockedIncrement(&fullWaiters);
+			if (TryPush(item)) {
+				InterlockedDecrement(&fullWaiters);
+				return true;
+			}
+			// 그 사이 소비자가 꺼냈다면 popSignal이 바뀌어 바로 돌아옴
+			WaitOnAddress(&popSignal, &signal, sizeof(LONG), INFINITE);
+			InterlockedDecrement(&fullWaiters);
+		}
+		return false;
+	}
+
+	// 소비자 전용. 기다리지 않고 하나 꺼냄. 꺼낸 뒤에는 NotifyPopped로 생산자를 깨워야 함
+	bool TryPop(ActionItem* out) {
+		Cell& cell = cells[dequeuePos & mask];
+		if (cell.sequence != (LONG)((ULONG)dequeuePos + 1)) return false; // 비었거나 아직 쓰는 중
+		*out = cell.item;
+		InterlockedExchange(&cell.sequence, (LONG)((ULONG)dequeuePos + (ULONG)cells.size()));
+		dequeuePos = (LONG)((ULONG)dequeuePos + 1);
+		return true;
+	}
+
+	// 소비자 전용. 다음 칸에 항목이 공개되어 있는지
+	bool HasItem() const {
+		return cells[dequeuePos & mask].sequence == (LONG)((ULONG)dequeuePos + 1);
+	}
+
+	// 자리가 났으니 가득 차서 잠든 생산자들을 한 번에 깨움
+	void NotifyPopped() {
+		if (fullWaiters) {
+			InterlockedIncrement(&popSignal);
+			WakeByAddressAll((PVOID)&popSignal);
+		}
+	}
+
+	// 쌓인 항목을 최대 maxItems개까지 모두 꺼냄. 비어 있으면 timeoutMs까지 잠듦
+	// 꺼낸 개수를 반환. 0이면 시간 초과이거나 닫힌 뒤 비었음
+	size_t Drain(std::vector<ActionItem>& out, size_t maxItems, DWORD timeoutMs = INFINITE) {
+		out.clear();
+		ActionItem item;
+		for (;;) {
+			while (out.size() < maxItems && TryPop(&item)) out.push_back(item);
+			if (!out.empty() || closed) break;
+
+			LONG signal = pushSignal;
+			InterlockedExchange(&consumerWaiting, 1);
+			if (HasItem() || closed) {
+				InterlockedExchange(&consumerWaiting, 0);
+				continue;
+			}
+			if (!WaitOnAddress(&pushSignal, &signal, sizeof(LONG), timeoutMs) && GetLastError() == ERROR_TIMEOUT) {
+				InterlockedExchange(&consumerWaiting, 0);
+				break;
+			}
+		}
+
+		if (!out.empty()) NotifyPopped();
+		return out.size();
+	}
+
+	// 더 이상 넣지 않음. 잠든 소비자/생산자를 깨움 (남은 항목은 Drain으로 꺼낼 수 있음)
+	void Close() {
+		InterlockedExchange(&closed, 1);
+		InterlockedIncrement(&pushSignal);
+		WakeByAddressAll((PVOID)&pushSignal);
+		InterlockedIncrement(&popSignal);
+		WakeByAddressAll((PVOID)&popSignal);
+	}
+};
+
+inline LONGLONG nowQpc() {
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+	return now.QuadPart;
+}
+
+double percentile(std::vector<double>& sorted, double ratio) {
+	if (sorted.empty()) return 0.0;
+	return sorted[(size_t)(ratio * (sorted.size() - 1) + 0.5)];
+}
+
+// 지연(마이크로초) 목록의 백분위 출력
+void printLatency(const char* label, std::vector<double> latencyUs) {
+	std::sort(latencyUs.begin(), latencyUs.end());
+	printf("%s: p50 %.1fus, p90 %.1fus, p99 %.1fus, p99.9 %.1fus, 최대 %.1fus (%zu개)\n", label,
+		percentile(latencyUs, 0.5), percentile(latencyUs, 0.9), percentile(latencyUs, 0.99),
+		percentile(latencyUs, 0.999), percentile(latencyUs, 1.0), latencyUs.size());
+}
+
+// ------------------------------------------------------------
+// 우선순위 레인 + 합치기(coalescing) + 프레임 예산
+// ActionQueue 하나는 긴급도와 상관없이 FIFO라서, 치장(cosmetic) 액션이 쏟아지면 입력
+// 액션도 그 뒤에 줄을 섭니다. PriorityActionQueue는 레인마다 ActionQueue를 두고
+// 가중치(입력 8 : 전투 4 : 치장 1)만큼씩 번갈아 꺼내 낮은 레인도 굶지 않게 합니다.
+//   - 합치기: 같은 유닛의 같은 종류 액션이 아직 처리 전이면 새 액션이 내용을 덮어씀.
+//     큐에는 슬롯 토큰 하나만 들어가므로 중복 액션이 큐 자리를 차지하지 않음
+//   - DrainFrame: 프레임마다 최대 개수와 시간 예산 안에서만 처리하고 나머지는 다음 프레임으로
+//   - 치장 레인은 가득 차면 기다리지 않고 버림 (입력/전투 레인은 자리가 날 때까지 대기)
+// ------------------------------------------------------------
+enum ActionLane {
+	kLaneInput,
+	kLaneCombat,
+	kLaneCosmetic,
+	kLaneCount
+};
+
+#define MAX_ACTION_KINDS 8
+
+struct LaneStats {
+	LONGLONG processed[kLaneCount];
+	LONG coalesced; // 처리 전에 새 액션으로 덮어쓴 횟수
+	LONG dropped;   // 레인이 가득 차 버린 횟수
+};
+
+class PriorityActionQueue {
+private:
+	struct CoalesceSlot {
+		SRWLOCK lock;
+		bool pending;       // 큐에 토큰이 들어가 있음
+		LONG merged;        // 이번 토큰에 덮어쓴 횟수 (토큰을 못 넣으면 이만큼 버린 것으로 셈)
+		ActionItem item;    // 가장 최근 액션
+	};
+
+	std::unique_ptr<ActionQueue> lanes[kLaneCount];
+	int weights[kLaneCount];
+	bool dropWhenFull[kLaneCount];
+	std::vector<CoalesceSlot> slots;
+	int maxUnits;
+
+	volatile LONG pushSignal;
+	volatile LONG consumerWaiting;
+	volatile LONG coalesced;
+	volatile LONG dropped;
+	LONGLONG processed[kLaneCount]; // 소비자만 갱신
+
+	bool PushToLane(int lane, const ActionItem& item) {
+		if (dropWhenFull[lane]) {
+			if (!lanes[lane]->TryPush(item)) {
+				InterlockedIncrement(&dropped);
+				return false;
+			}
+		}
+		else if (!lanes[lane]->Push(item)) {
+			return false;
+		}
+		// 레인 공개(전체 장벽) 뒤에 읽으므로 잠든 소비자를 놓치지 않음
+		if (consumerWaiting && InterlockedExchange(&consumerWaiting, 0) != 0) {
+			InterlockedIncrement(&pushSignal);
+			WakeByAddressSingle((PVOID)&pushSignal);
+		}
+		return true;
+	}
+
+	// 토큰이면 슬롯의 최신 액션으로 바꿔 줌. 이미 비워진 슬롯이면 false
+	bool ResolveToken(ActionItem& item) {
+		if (item.coalesceKey == 0) return true;
+		CoalesceSlot& slot = slots[item.coalesceKey - 1];
+		AcquireSRWLockExclusive(&slot.lock);
+		bool pending = slot.pending;
+		if (pending) {
+			item = slot.item;
+			slot.pending = false;
+			slot.merged = 0;
+		}
+		ReleaseSRWLockExclusive(&slot.lock);
+		return pending;
+	}
+
+public:
+	PriorityActionQueue(LONG laneCapacity, int maxUnits) : slots(maxUnits * MAX_ACTION_KINDS), maxUnits(maxUnits),
+		pushSignal(0), consumerWaiting(0), coalesced(0), dropped(0) {
+		const int defaultWeights[kLaneCount] = { 8, 4, 1 };
+		for (int i = 0; i < kLaneCount; ++i) {
+			lanes[i].reset(new ActionQueue(laneCapacity));
+			weights[i] = defaultWeights[i];
+			dropWhenFull[i] = (i == kLaneCosmetic);
+			processed[i] = 0;
+		}
+		for (CoalesceSlot& slot : slots) {
+			InitializeSRWLock(&slot.lock);
+			slot.pending = false;
+			slot.merged = 0;
+		}
+	}
+
+	void SetWeight(int lane, int weight) { weights[lane] = weight < 1 ? 1 : weight; }
+
+	// coalesce가 true면 같은 (unitId, kind)의 처리 전 액션을 덮어씀
+	// 버려졌으면(치장 레인이 가득 참) false
+	bool Push(int lane, ActionItem item, bool coalesce = false) {
+		item.coalesceKey = 0;
+		if (!coalesce || item.unitId < 0 || item.unitId >= maxUnits || item.kind < 0 || item.kind >= MAX_ACTION_KINDS) {
+			return PushToLane(lane, item);
+		}
+
+		int index = item.unitId * MAX_ACTION_KINDS + item.kind;
+		CoalesceSlot& slot = slots[index];
+		AcquireSRWLockExclusive(&slot.lock);
+		bool replaced = slot.pending;
+		slot.item = item;
+		slot.item.coalesceKey = 0;
+		slot.pending = true;
+		slot.merged = replaced ? slot.merged + 1 : 0;
+		ReleaseSRWLockExclusive(&slot.lock);
+
+		if (replaced) {
+			// 큐에 이미 토큰이 있으니 그 토큰이 최신 액션을 가져감
+			InterlockedIncrement(&coalesced);
+			return true;
+		}
+
+		ActionItem token = item;
+		token.coalesceKey = index + 1;
+		if (PushToLane(lane, token)) return true;
+
+		// 토큰을 넣지 못하면 슬롯이 영원히 pending으로 남지 않도록 되돌림
+		// 그 사이 이 슬롯에 합쳐진 액션들도 처리되지 않으므로 합침에서 버림으로 옮김
+		AcquireSRWLockExclusive(&slot.lock);
+		LONG lost = slot.merged;
+		slot.pending = false;
+		slot.merged = 0;
+		ReleaseSRWLockExclusive(&slot.lock);
+		if (lost > 0) {
+			InterlockedExchangeAdd(&coalesced, -lost);
+			InterlockedExchangeAdd(&dropped, lost);
+		}
+		return false;
+	}
+
+	// 레인 가중치대로 번갈아 꺼내 handle(lane, item)을 호출
+	// maxItems개 또는 budgetUs 마이크로초를 넘으면 멈추고 처리한 개수를 반환
+	template <typename Handler>
+	size_t DrainFrame(Handler handle, size_t maxItems, double budgetUs) {
+		LARGE_INTEGER frequency;
+		QueryPerformanceFrequency(&frequency);
+		LONGLONG deadline = nowQpc() + (LONGLONG)(budgetUs * frequency.QuadPart / 1000000.0);
+		bool popped[kLaneCount] = {};
+		size_t count = 0;
+
+		bool any = true;
+		while (any && count < maxItems && nowQpc() < deadline) {
+			any = false;
+			for (int lane = 0; lane < kLaneCount; ++lane) {
+				ActionItem item;
+				for (int taken = 0; taken < weights[lane] && count < maxItems; ++taken) {
+					if (!lanes[lane]->TryPop(&item)) break;
+					any = true;
+					popped[lane] = true;
+					if (!ResolveToken(item)) continue;
+					handle(lane, item);
+					++processed[lane];
+					++count;
+				}
+			}
+		}
+
+		for (int lane = 0; lane < kLaneCount; ++lane) {
+			if (popped[lane]) lanes[lane]->NotifyPopped();
+		}
+		return count;
+	}
+
+	// 소비자 전용. 어느 레인에든 항목이 들어올 때까지 최대 timeoutMs 잠듦
+	bool WaitForWork(DWORD timeoutMs) {
+		LONG signal = pushSignal;
+		InterlockedExchange(&consumerWaiting, 1);
+		for (int lane = 0; lane < kLaneCount; ++lane) {
+			if (lanes[lane]->HasItem()) {
+				InterlockedExchange(&consumerWaiting, 0);
+				return true;
+			}
+		}
+		BOOL woke = WaitOnAddress(&pushSignal, &signal, sizeof(LONG), timeoutMs);
+		InterlockedExchange(&consumerWaiting, 0);
+		return woke != FALSE;
+	}
+
+	// 소비자 스레드에서 호출
+	LaneStats GetStats() const {
+		LaneStats stats;
+		for (int i = 0; i < kLaneCount; ++i) stats.processed[i] = processed[i];
+		stats.coalesced = coalesced;
+		stats.dropped = dropped;
+		return stats;
+	}
+};
+
 // --- 공유 자원 ---
-int g_actionQueue[MAX_QUEUE_SIZE];
-int g_itemCount = 0;
-int g_writeIndex = 0;
-int g_readIndex = 0;
-CRITICAL_SECTION cs_queue;
+ActionQueue g_actionQueue(MAX_QUEUE_SIZE);
 
 // 생산자: AI 유닛 스레드
 unsigned int __stdcall aiUnitThread(void* arg) {
@@ -20,33 +400,14 @@ unsigned int __stdcall aiUnitThread(void* arg) {
 	srand(unitId); // 각 스레드마다 다른 시드값 부여
 
 	for (int i = 0; i < NUM_ACTIONS; ++i) {
-		int newAction = unitId * 100 + i; // 유닛 고유의 액션 생성
-		bool success = false;
-
-		while (!success) {
-			// TODO 1: 큐에 접근하기 위해 크리티컬 섹션에 진입하세요.
-			// ...
-			EnterCriticalSection(&cs_queue);
-			if (g_itemCount < MAX_QUEUE_SIZE) {
-				// 큐에 자리가 있을 때의 로직
-				g_actionQueue[g_writeIndex] = newAction;
-				g_writeIndex = (g_writeIndex + 1) % MAX_QUEUE_SIZE;
-				g_itemCount++;
-				printf("유닛 %d: 액션 %d 큐에 등록. (현재 %d개)\n", unitId, newAction, g_itemCount);
-				success = true;
-			}
-			else {
-				// 큐가 가득 찼을 때의 로직
-				printf(">> 유닛 %d: 큐가 가득 차 등록에 실패했습니다. 잠시 대기...\n", unitId);
-			}
+		ActionItem newAction = { unitId * 100 + i, nowQpc() }; // 유닛 고유의 액션 생성
+		bool waited = false;
+
+		// 큐가 가득 찼으면 엔진이 꺼낼 때까지 잠들었다가 바로 등록됨
+		if (!g_actionQueue.Push(newAction, &waited)) break;
+		if (waited) printf(">> 유닛 %d: 큐가 가득 차 자리가 날 때까지 기다렸습니다.\n", unitId);
+		printf("유닛 %d: 액션 %d 큐에 등록. (현재 약 %ld개)\n", unitId, newAction.action, g_actionQueue.ApproxSize());
 
-			// TODO 2: 큐 접근이 끝났으니 크리티컬 섹션을 빠져나오세요.
-			// ...
-			LeaveCriticalSection(&cs_queue);
-			if (!success) {
-				Sleep(100); // 큐가 꽉 찼으면 잠시 대기 후 재시도
-			}
-		}
 		Sleep(rand() % 150); // 새로운 액션을 생각하는 시간
 	}
 	return 0;
@@ -56,39 +417,277 @@ unsigned int __stdcall aiUnitThread(void* arg) {
 unsigned int __stdcall gameEngineThread(void* arg) {
 	int totalActionsToProcess = NUM_UNITS * NUM_ACTIONS;
 	int processedCount = 0;
+	std::vector<ActionItem> batch;
+	std::vector<double> latencyUs;
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
 
 	while (processedCount < totalActionsToProcess) {
-		// TODO 3: 큐에 접근하기 위해 크리티컬 섹션에 진입하세요.
-		// ...
-		EnterCriticalSection(&cs_queue);
-		if (g_itemCount > 0) {
-			// 큐에 아이템이 있을 때의 로직
-			int action = g_actionQueue[g_readIndex];
-			g_readIndex = (g_readIndex + 1) % MAX_QUEUE_SIZE;
-			g_itemCount--;
+		// 비어 있으면 액션이 들어올 때까지 잠들고, 깨어나면 쌓인 액션을 전부 처리
+		if (g_actionQueue.Drain(batch, MAX_QUEUE_SIZE) == 0) break;
+		LONGLONG now = nowQpc();
+		for (const ActionItem& item : batch) {
 			processedCount++;
-			printf("엔진: 액션 %d 처리 완료. (남은 %d개, 총 %d개 처리)\n", action, g_itemCount, processedCount);
+			latencyUs.push_back((double)(now - item.enqueueQpc) * 1000000.0 / frequency.QuadPart);
+			printf("엔진: 액션 %d 처리 완료. (이번에 %zu개, 총 %d개 처리)\n", item.action, batch.size(), processedCount);
+		}
+	}
+
+	printLatency("\n등록 ~ 처리 지연", latencyUs);
+	return 0;
+}
+
+// ------------------------------------------------------------
+// 벤치마크: 폴링 링 버퍼 vs 블로킹 MPSC 큐의 등록 ~ 처리 지연
+// ------------------------------------------------------------
+#define BENCH_PRODUCERS 4
+#define BENCH_ACTIONS_PER_PRODUCER 100000
+#define BENCH_QUEUE_SIZE 1024
+
+// 예전 방식 재현: 크리티컬 섹션 + 링 버퍼. 차거나 비면 1ms 잠든 뒤 다시 확인
+struct PollingQueue {
+	ActionItem items[BENCH_QUEUE_SIZE];
+	int count;
+	int writeIndex;
+	int readIndex;
+	CRITICAL_SECTION cs;
+};
+
+struct QueueBenchParam {
+	bool polling;
+	PollingQueue* pollingQueue;
+	ActionQueue* queue;
+	int producerId;
+	int burst; // 액션을 이만큼 보낸 뒤 1ms 쉼 (0이면 쉬지 않음)
+};
+
+unsigned int __stdcall benchProducer(void* arg) {
+	QueueBenchParam* param = (QueueBenchParam*)arg;
+	for (int i = 0; i < BENCH_ACTIONS_PER_PRODUCER; ++i) {
+		ActionItem item = { param->producerId * BENCH_ACTIONS_PER_PRODUCER + i, nowQpc() };
+		if (param->polling) {
+			PollingQueue* q = param->pollingQueue;
+			for (;;) {
+				EnterCriticalSection(&q->cs);
+				bool pushed = q->count < BENCH_QUEUE_SIZE;
+				if (pushed) {
+					q->items[q->writeIndex] = item;
+					q->writeIndex = (q->writeIndex + 1) % BENCH_QUEUE_SIZE;
+					q->count++;
+				}
+				LeaveCriticalSection(&q->cs);
+				if (pushed) break;
+				Sleep(1);
+			}
 		}
 		else {
-			// 큐가 비어있을 때의 로직
-			// (실제 엔진이라면 대기하겠지만, 여기서는 메시지만 출력)
-			printf(" 큐가 비어있습니다... 대기 중 ... \n");
+			param->queue->Push(item);
+		}
+		if (param->burst && (i + 1) % param->burst == 0) Sleep(1);
+	}
+	return 0;
+}
+
+void runQueueBench(const char* label, bool polling, int burst) {
+	PollingQueue* pollingQueue = new PollingQueue();
+	pollingQueue->count = pollingQueue->writeIndex = pollingQueue->readIndex = 0;
+	InitializeCriticalSection(&pollingQueue->cs);
+	ActionQueue queue(BENCH_QUEUE_SIZE);
+
+	QueueBenchParam params[BENCH_PRODUCERS];
+	std::vector<HANDLE> producers;
+	LONGLONG start = nowQpc();
+	for (int i = 0; i < BENCH_PRODUCERS; ++i) {
+		params[i] = { polling, pollingQueue, &queue, i, burst };
+		HANDLE hThread = (HANDLE)_beginthreadex(NULL, 0, benchProducer, &params[i], 0, NULL);
+		if (hThread) producers.push_back(hThread);
+	}
+
+	// 이 스레드가 엔진 역할
+	const size_t total = producers.size() * BENCH_ACTIONS_PER_PRODUCER;
+	std::vector<double> latencyUs;
+	latencyUs.reserve(total);
+	std::vector<ActionItem> batch;
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	long long checksum = 0;
+	while (latencyUs.size() < total) {
+		if (polling) {
+			batch.clear();
+			EnterCriticalSection(&pollingQueue->cs);
+			if (pollingQueue->count > 0) {
+				batch.push_back(pollingQueue->items[pollingQueue->readIndex]);
+				pollingQueue->readIndex = (pollingQueue->readIndex + 1) % BENCH_QUEUE_SIZE;
+				pollingQueue->count--;
+			}
+			LeaveCriticalSection(&pollingQueue->cs);
+			if (batch.empty()) {
+				Sleep(1);
+				continue;
+			}
+		}
+		else if (queue.Drain(batch, BENCH_QUEUE_SIZE) == 0) {
+			break;
 		}
+		LONGLONG now = nowQpc();
+		for (const ActionItem& item : batch) {
+			checksum += item.action;
+			latencyUs.push_back((double)(now - item.enqueueQpc) * 1000000.0 / frequency.QuadPart);
+		}
+	}
+	double elapsed = (double)(nowQpc() - start) / frequency.QuadPart;
+
+	WaitForMultipleObjects((DWORD)producers.size(), producers.data(), TRUE, INFINITE);
+	for (HANDLE h : producers) CloseHandle(h);
+	DeleteCriticalSection(&pollingQueue->cs);
+	delete pollingQueue;
+
+	long long expected = (long long)total * (total - 1) / 2;
+	printf("%s: %.0f 액션/초, 합계 검사 %s\n", label, latencyUs.size() / elapsed, checksum == expected ? "통과" : "실패");
+	printLatency("  등록 ~ 처리 지연", latencyUs);
+}
+
+void benchmarkActionQueue() {
+	printf("=== 생산자 %d개 x %d 액션, 큐 크기 %d ===\n", BENCH_PRODUCERS, BENCH_ACTIONS_PER_PRODUCER, BENCH_QUEUE_SIZE);
+	runQueueBench("폴링 (띄엄띄엄 등록)", true, 100);
+	runQueueBench("MPSC (띄엄띄엄 등록)", false, 100);
+	runQueueBench("폴링 (쉬지 않고 등록)", true, 0);
+	runQueueBench("MPSC (쉬지 않고 등록)", false, 0);
+}
+
+// ------------------------------------------------------------
+// 벤치마크: 치장 액션 폭주 중 입력 액션 지연
+// ------------------------------------------------------------
+#define LANE_FLOOD_PRODUCERS 4
+#define LANE_FLOOD_UNITS 256
+#define LANE_INPUT_ACTIONS 2000
+
+enum LaneBenchMode {
+	kLaneBenchFifo,         // 모든 액션을 한 레인에 (기존 FIFO와 같음)
+	kLaneBenchLanes,        // 우선순위 레인
+	kLaneBenchCoalesce      // 우선순위 레인 + 합치기
+};
+
+struct LaneBenchShared {
+	PriorityActionQueue* queue;
+	LaneBenchMode mode;
+	volatile bool stop;
+};
+
+struct LaneFloodParam {
+	LaneBenchShared* shared;
+	int producerId;
+	LONGLONG sent;
+};
+
+// 치장 액션(이모트, 이펙트 등)을 쉬지 않고 보냄
+unsigned int __stdcall laneFloodProducer(void* arg) {
+	LaneFloodParam* param = (LaneFloodParam*)arg;
+	LaneBenchShared* shared = param->shared;
+	int lane = shared->mode == kLaneBenchFifo ? kLaneCombat : kLaneCosmetic;
+	bool coalesce = shared->mode == kLaneBenchCoalesce;
+	unsigned seed = (unsigned)param->producerId * 7919u + 1;
+
+	while (!shared->stop) {
+		seed = seed * 1103515245u + 12345u;
+		ActionItem item = { (int)(seed >> 8), nowQpc(), (int)((seed >> 16) % LANE_FLOOD_UNITS), (int)(seed % 2) };
+		shared->queue->Push(lane, item, coalesce);
+		++param->sent;
+	}
+	return 0;
+}
 
-		// TODO 4: 큐 접근이 끝났으니 크리티컬 섹션을 빠져나오세요.
-		// ...
-		LeaveCriticalSection(&cs_queue);
-		Sleep(50); // 한 액션을 처리하는데 걸리는 시간
+// 입력 액션은 1ms마다 하나씩 보냄
+unsigned int __stdcall laneInputProducer(void* arg) {
+	LaneBenchShared* shared = (LaneBenchShared*)arg;
+	int lane = shared->mode == kLaneBenchFifo ? kLaneCombat : kLaneInput;
+	for (int i = 0; i < LANE_INPUT_ACTIONS && !shared->stop; ++i) {
+		ActionItem item = { -1 - i, nowQpc(), 0, 0 };
+		shared->queue->Push(lane, item);
+		Sleep(1);
 	}
 	return 0;
 }
 
+volatile unsigned g_actionSink = 0; // 처리 결과가 최적화로 사라지지 않도록
 
-int main()
+// 액션 하나를 처리하는 비용 흉내 (약 수 마이크로초)
+inline unsigned simulateActionWork(int action) {
+	unsigned value = (unsigned)action;
+	for (int i = 0; i < 2000; ++i) value = value * 1664525u + 1013904223u;
+	return value;
+}
+
+void runLaneBench(const char* label, LaneBenchMode mode) {
+	PriorityActionQueue queue(4096, LANE_FLOOD_UNITS);
+	LaneBenchShared shared = { &queue, mode, false };
+
+	HANDLE hInput = (HANDLE)_beginthreadex(NULL, 0, laneInputProducer, &shared, 0, NULL);
+	LaneFloodParam floods[LANE_FLOOD_PRODUCERS];
+	std::vector<HANDLE> floodThreads;
+	for (int i = 0; i < LANE_FLOOD_PRODUCERS; ++i) {
+		floods[i] = { &shared, i, 0 };
+		HANDLE hThread = (HANDLE)_beginthreadex(NULL, 0, laneFloodProducer, &floods[i], 0, NULL);
+		if (hThread) floodThreads.push_back(hThread);
+	}
+
+	// 이 스레드가 엔진: 프레임마다 최대 512개, 2ms 예산
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	std::vector<double> inputLatencyUs;
+	unsigned sink = 0;
+	int frames = 0;
+	while (inputLatencyUs.size() < LANE_INPUT_ACTIONS) {
+		size_t handled = queue.DrainFrame([&](int lane, const ActionItem& item) {
+			sink += simulateActionWork(item.action);
+			if (item.action < 0) {
+				inputLatencyUs.push_back((double)(nowQpc() - item.enqueueQpc) * 1000000.0 / frequency.QuadPart);
+			}
+		}, 512, 2000.0);
+		++frames;
+		if (handled == 0) queue.WaitForWork(1);
+		if (WaitForSingleObject(hInput, 0) == WAIT_OBJECT_0 && inputLatencyUs.size() >= LANE_INPUT_ACTIONS) break;
+	}
+
+	// 생산자를 멈추고, 막혀 있는 생산자가 빠져나오도록 남은 항목을 비움
+	shared.stop = true;
+	for (;;) {
+		DWORD waitResult = WaitForMultipleObjects((DWORD)floodThreads.size(), floodThreads.data(), TRUE, 0);
+		if (waitResult != WAIT_TIMEOUT) break;
+		queue.DrainFrame([&](int, const ActionItem& item) { sink += (unsigned)item.action; }, 100000, 100000.0);
+		Sleep(1);
+	}
+	WaitForSingleObject(hInput, INFINITE);
+	CloseHandle(hInput);
+	for (HANDLE h : floodThreads) CloseHandle(h);
+
+	LaneStats stats = queue.GetStats();
+	LONGLONG sent = 0;
+	for (const LaneFloodParam& flood : floods) sent += flood.sent;
+	g_actionSink += sink;
+	printf("%s (프레임 %d, 폭주 액션 %lld개 전송, 합침 %ld, 버림 %ld)\n", label, frames, sent, stats.coalesced, stats.dropped);
+	printLatency("  입력 액션 지연", inputLatencyUs);
+}
+
+void benchmarkPriorityLanes() {
+	printf("=== 치장 액션 폭주(생산자 %d개, 유닛 %d개) 중 입력 액션 %d개의 등록 ~ 처리 지연 ===\n",
+		LANE_FLOOD_PRODUCERS, LANE_FLOOD_UNITS, LANE_INPUT_ACTIONS);
+	runLaneBench("단일 FIFO          ", kLaneBenchFifo);
+	runLaneBench("우선순위 레인      ", kLaneBenchLanes);
+	runLaneBench("레인 + 유닛별 합치기", kLaneBenchCoalesce);
+}
+
+int main(int argc, char* argv[])
 {
-	// TODO 5: 크리티컬 섹션을 초기화하세요.
-	// ...
-	InitializeCriticalSection(&cs_queue);
+	if (argc > 1 && strcmp(argv[1], "--bench-queue") == 0) {
+		benchmarkActionQueue();
+		return 0;
+	}
+	if (argc > 1 && strcmp(argv[1], "--bench-lanes") == 0) {
+		benchmarkPriorityLanes();
+		return 0;
+	}
+
 	std::vector<HANDLE> unitThreads;
 	std::vector<int> unitIds(NUM_UNITS+1, 0);
 
@@ -107,9 +706,6 @@ int main()
 	for (HANDLE h : unitThreads) CloseHandle(h);
 	CloseHandle(hEngineThread);
 
-	// TODO 6: 크리티컬 섹션을 삭제하세요.
-	// ...
-	DeleteCriticalSection(&cs_queue);
 	printf("\n모든 게임 액션 처리 완료.\n");
 	return 0;
-}
\ No newline at end of file
+}
@@ -2,6 +2,11 @@
 #include <strsafe.h>   // StringCchPrintfA
 #include <iostream>
 #include <vector>
+#include <string>
+#include <memory>
+#include <atomic>
+#include <algorithm>
+#include <unordered_map>
 using namespace std;
 
 struct ThreadData {
@@ -10,13 +15,11 @@ struct ThreadData {
 	int count;
 };
 
-// 스레드에서 사용할 간단한 WinAPI 로그 함수
-void Logf(const char* fmt, ...)
+// 스레드에서 사용할 간단한 WinAPI 로그 함수 (동기 방식)
+void LogfSyncV(const char* fmt, va_list ap)
 {
 	char buf[512];
-	va_list ap; va_start(ap, fmt);
 	StringCchVPrintfA(buf, 512, fmt, ap);
-	va_end(ap);
 
 	DWORD written = 0;
 	HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
@@ -27,27 +30,920 @@ void Logf(const char* fmt, ...)
 	OutputDebugStringA(buf);
 }
 
+// ============================================================================
+// 비동기 로거
+// ============================================================================
+// 동기 Logf는 호출한 워커 스레드에서 매번 WriteConsoleA + OutputDebugStringA
+// 시스템 콜을 하므로, 콘솔 출력이 느리면 워커도 같이 멈춥니다.
+// AsyncLogger는 스레드마다 SPSC 링 버퍼를 하나씩 두고, 워커는 레코드만 넣고 바로
+// 돌아갑니다. 백그라운드 스레드 하나가 모든 링을 모아서 한 번의 WriteFile로
+// 묶어서 출력합니다. (Windows에는 writev가 없으므로 배치 버퍼 하나로 모아서 씀)
+
+enum class LogFullPolicy
+{
+	Drop,   // 링이 가득 차면 레코드를 버리고 개수만 센다
+	Block   // 링에 자리가 날 때까지 호출 스레드가 기다린다
+};
+
+// ----------------------------------------------------------------------------
+// 지연 포맷(deferred formatting) 로그
+// ----------------------------------------------------------------------------
+// 비동기 로거를 써도 Logf는 호출 스레드에서 StringCchVPrintfA로 문자열을 만듭니다.
+// LOGF_DEFERRED 매크로는 호출 위치마다 static LogSite(포맷 문자열, 파일, 줄)를
+// 하나 두고, 레코드에는 LogSite 주소와 인자 원본 값만 복사합니다.
+// 실제 포맷은 로거 스레드가 하거나(텍스트 출력), 바이너리 로그 파일로 저장한 뒤
+// 디코더(--decode)가 나중에 합니다.
+
+struct LogSite
+{
+	const char* format;
+	const char* file;
+	int line;
+};
+
+// 인자 앞에 붙는 1바이트 타입 태그
+enum LogArgTag : char
+{
+	kLogArgInt32 = 'i',
+	kLogArgUInt32 = 'u',
+	kLogArgInt64 = 'l',
+	kLogArgUInt64 = 'L',
+	kLogArgDouble = 'd',
+	kLogArgString = 's',
+	kLogArgPointer = 'p'
+};
+
+template <typename T>
+inline bool EncodeLogRaw(char*& out, char* end, LogArgTag tag, const T& value)
+{
+	if (end - out < (ptrdiff_t)(1 + sizeof(T))) return false;
+	*out++ = tag;
+	memcpy(out, &value, sizeof(T));
+	out += sizeof(T);
+	return true;
+}
+
+inline bool EncodeLogArg(char*& out, char* end, int v) { return EncodeLogRaw(out, end, kLogArgInt32, (INT32)v); }
+inline bool EncodeLogArg(char*& out, char* end, long v) { return EncodeLogRaw(out, end, kLogArgInt64, (LONGLONG)v); }
+inline bool EncodeLogArg(char*& out, char* end, long long v) { return EncodeLogRaw(out, end, kLogArgInt64, (LONGLONG)v); }
+inline bool EncodeLogArg(char*& out, char* end, unsigned v) { return EncodeLogRaw(out, end, kLogArgUInt32, (UINT32)v); }
+inline bool EncodeLogArg(char*& out, char* end, unsigned long v) { return EncodeLogRaw(out, end, kLogArgUInt64, (ULONGLONG)v); }
+inline bool EncodeLogArg(char*& out, char* end, unsigned long long v) { return EncodeLogRaw(out, end, kLogArgUInt64, (ULONGLONG)v); }
+inline bool EncodeLogArg(char*& out, char* end, double v) { return EncodeLogRaw(out, end, kLogArgDouble, v); }
+inline bool EncodeLogArg(char*& out, char* end, const void* v) { return EncodeLogRaw(out, end, kLogArgPointer, (ULONGLONG)(ULONG_PTR)v); }
+
+// 문자열은 포인터가 나중에 무효가 될 수 있으므로 내용을 복사 (남은 공간만큼만)
+inline bool EncodeLogArg(char*& out, char* end, const char* v)
+{
+	if (v == nullptr) v = "(null)";
+	if (end - out < 3) return false;
+	size_t length = min(strlen(v), (size_t)(end - out - 3));
+	*out++ = kLogArgString;
+	WORD length16 = (WORD)length;
+	memcpy(out, &length16, sizeof(WORD));
+	out += sizeof(WORD);
+	memcpy(out, v, length);
+	out += length;
+	return true;
+}
+
+// 인자를 레코드 버퍼에 순서대로 기록하고 사용한 바이트 수를 반환
+template <typename... Args>
+size_t EncodeLogArgs(char* buffer, size_t capacity, const Args&... args)
+{
+	char* out = buffer;
+	char* end = buffer + capacity;
+	bool ok = true;
+	int expand[] = { 0, (ok = ok && EncodeLogArg(out, end, args), 0)... };
+	(void)expand;
+	return out - buffer;
+}
+
+// 포맷 문자열의 변환 지정자를 하나씩 찾아, 저장된 인자 타입에 맞게 개별 포맷
+void FormatDeferred(const char* fmt, const char* payload, size_t size, string& out)
+{
+	const char* arg = payload;
+	const char* argEnd = payload + size;
+	char spec[32];
+	char buf[256];
+
+	for (const char* p = fmt; *p; ++p) {
+		if (*p != '%') { out += *p; continue; }
+		if (p[1] == '%') { out += '%'; ++p; continue; }
+
+		// % [플래그] [폭] [.정밀도] [길이] 변환문자
+		size_t specLength = 0;
+		spec[specLength++] = '%';
+		++p;
+		while (*p && strchr("-+ #0123456789.", *p) && specLength < sizeof(spec) - 4) spec[specLength++] = *p++;
+		while (*p && strchr("hlLqjzt", *p)) ++p;   // 길이 지정자는 저장된 타입으로 다시 정함
+		if (*p == '\0') break;
+		char conversion = *p;
+
+		if (arg >= argEnd) { out += "<?>"; continue; }
+		char tag = *arg++;
+
+		// 파일에서 읽은 페이로드는 잘렸거나 손상됐을 수 있음
+		// 읽기 전에 남은 길이를 확인하고, 모자라면 <?>로 줄을 끝내고 이 레코드는 여기서 멈춤
+		size_t left = (size_t)(argEnd - arg);
+
+		if (tag == kLogArgString) {
+			WORD length = 0;
+			if (left < sizeof(WORD)) { out += "<?>\r\n"; return; }
+			memcpy(&length, arg, sizeof(WORD));
+			arg += sizeof(WORD);
+			if (left - sizeof(WORD) < length) { out += "<?>\r\n"; return; }
+			string text(arg, length);
+			arg += length;
+			if (conversion == 's') {
+				spec[specLength++] = 's';
+				spec[specLength] = '\0';
+				StringCchPrintfA(buf, 256, spec, text.c_str());
+				out += buf;
+			}
+			else out += text;
+			continue;
+		}
+
+		size_t width = (tag == kLogArgInt32 || tag == kLogArgUInt32) ? 4 : 8;
+		if (left < width) { out += "<?>\r\n"; return; }
+
+		if (conversion == 's') {   // 숫자 인자를 %s로 찍으려는 잘못된 호출은 크래시 대신 표시만
+			out += "<?>";
+			arg += width;
+			continue;
+		}
+
+		// 저장된 값을 정수/실수로 읽은 뒤, 변환 문자에 맞는 타입으로 넘김
+		LONGLONG integer = 0;
+		double real = 0.0;
+		switch (tag) {
+		case kLogArgInt32: {
+			INT32 v;
+			memcpy(&v, arg, sizeof(v)); arg += sizeof(v);
+			integer = strchr("uxXo", conversion) ? (LONGLONG)(UINT32)v : v;
+			real = v;
+			break;
+		}
+		case kLogArgUInt32: {
+			UINT32 v;
+			memcpy(&v, arg, sizeof(v)); arg += sizeof(v);
+			integer = v;
+			real = v;
+			break;
+		}
+		case kLogArgInt64:
+		case kLogArgUInt64:
+		case kLogArgPointer: {
+			LONGLONG v;
+			memcpy(&v, arg, sizeof(v)); arg += sizeof(v);
+			integer = v;
+			real = (double)v;
+			break;
+		}
+		case kLogArgDouble: {
+			double v;
+			memcpy(&v, arg, sizeof(v)); arg += sizeof(v);
+			integer = (LONGLONG)v;
+			real = v;
+			break;
+		}
+		default:
+			out += "<?>";
+			arg = argEnd;
+			continue;
+		}
+
+		if (conversion == 'p') {
+			StringCchPrintfA(buf, 256, "0x%llx", (ULONGLONG)integer);
+		}
+		else if (strchr("eEfFgGaA", conversion)) {
+			spec[specLength++] = conversion;
+			spec[specLength] = '\0';
+			StringCchPrintfA(buf, 256, spec, real);
+		}
+		else {
+			spec[specLength++] = 'l';
+			spec[specLength++] = 'l';
+			spec[specLength++] = conversion;
+			spec[specLength] = '\0';
+			StringCchPrintfA(buf, 256, spec, integer);
+		}
+		out += buf;
+	}
+}
+
+// 바이너리 로그 파일 형식
+//   헤더: "MTLOG01\0" + QPC 주파수(8) + 시작 QPC(8)
+//   프레임: 1바이트 종류 + 내용
+//     kSite   : siteId(4) 줄(4) 포맷길이(2) 포맷 파일길이(2) 파일
+//     kEntry  : siteId(4) 시각(8) 스레드(4) 인자길이(2) 인자
+//     kText   : 시각(8) 스레드(4) 길이(2) 문자열
+//     kDropped: 스레드(4) 개수(8)
+const char kBinaryLogMagic[8] = { 'M', 'T', 'L', 'O', 'G', '0', '1', '\0' };
+
+enum BinaryLogFrame : char
+{
+	kFrameSite = 1,
+	kFrameEntry = 2,
+	kFrameText = 3,
+	kFrameDropped = 4
+};
+
+template <typename T>
+inline void AppendBinary(string& out, const T& value)
+{
+	out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+enum class LogOutputFormat
+{
+	Text,     // 로거 스레드가 문자열로 포맷해서 출력
+	Binary    // 인자 원본을 그대로 파일에 기록하고, 포맷은 디코더가 담당
+};
+
+// 링 버퍼에 들어가는 고정 크기 레코드 (기존 Logf의 512바이트 버퍼와 같은 크기)
+struct LogRecord
+{
+	LONGLONG timestamp;   // QueryPerformanceCounter 값
+	const LogSite* site;  // nullptr이면 text는 포맷된 문자열, 아니면 인코딩된 인자
+	DWORD threadId;
+	DWORD length;
+	char text[512 - sizeof(LONGLONG) - sizeof(void*) - sizeof(DWORD) * 2];
+};
+
+// 생산자 1명(워커 스레드), 소비자 1명(로거 스레드)인 링 버퍼
+class LogRing
+{
+public:
+	static const size_t kCapacity = 256;   // 2의 거듭제곱이어야 함
+
+	explicit LogRing(DWORD ownerThreadId) : m_ownerThreadId(ownerThreadId), m_head(0), m_tail(0), m_dropped(0), m_retired(false) {}
+
+	// 생산자: 쓸 자리를 얻는다. 가득 차면 nullptr
+	LogRecord* BeginWrite()
+	{
+		size_t head = m_head.load(memory_order_relaxed);
+		if (head - m_tail.load(memory_order_acquire) == kCapacity) return nullptr;
+		return &m_records[head & (kCapacity - 1)];
+	}
+
+	void CommitWrite()
+	{
+		m_head.store(m_head.load(memory_order_relaxed) + 1, memory_order_release);
+	}
+
+	// 소비자: 읽을 레코드를 얻는다. 비어 있으면 nullptr
+	const LogRecord* BeginRead()
+	{
+		size_t tail = m_tail.load(memory_order_relaxed);
+		if (tail == m_head.load(memory_order_acquire)) return nullptr;
+		return &m_records[tail & (kCapacity - 1)];
+	}
+
+	void CommitRead()
+	{
+		m_tail.store(m_tail.load(memory_order_relaxed) + 1, memory_order_release);
+	}
+
+	void AddDropped() { m_dropped.fetch_add(1, memory_order_relaxed); }
+	unsigned long long TakeDropped() { return m_dropped.exchange(0, memory_order_relaxed); }
+	DWORD GetOwnerThreadId() const { return m_ownerThreadId; }
+
+	// 생산자: 더 이상 쓰지 않음 (마지막 CommitWrite 뒤에 호출)
+	void Retire() { m_retired.store(true, memory_order_release); }
+
+	// 소비자: 은퇴했고 남은 레코드와 유실 보고가 없으면 해제해도 됨
+	bool IsFinished() const
+	{
+		return m_retired.load(memory_order_acquire) &&
+			m_tail.load(memory_order_relaxed) == m_head.load(memory_order_acquire) &&
+			m_dropped.load(memory_order_relaxed) == 0;
+	}
+
+private:
+	LogRecord m_records[kCapacity];
+	DWORD m_ownerThreadId;
+	// 생산자/소비자 인덱스가 같은 캐시 라인을 공유하지 않도록 패딩
+	char m_pad0[64];
+	atomic<size_t> m_head;   // 생산자만 씀
+	char m_pad1[64];
+	atomic<size_t> m_tail;   // 소비자만 씀
+	char m_pad2[64];
+	atomic<unsigned long long> m_dropped;
+	atomic<bool> m_retired;
+};
+
+class AsyncLogger
+{
+private:
+	// 한 번에 링 하나에서 꺼낼 최대 레코드 수 (한 스레드가 출력을 독점하지 않도록)
+	static const int kMaxRecordsPerRing = 64;
+
+	HANDLE m_hOutput;
+	LogFullPolicy m_policy;
+	bool m_debugOutput;
+	LogOutputFormat m_format;
+
+	// 링은 로거와 소유 스레드가 함께 잡음. 스레드가 끝나면 은퇴 표시만 하고,
+	// 로거 스레드가 다 비운 뒤 목록에서 빼서 해제
+	vector<shared_ptr<LogRing>> m_rings;
+	SRWLOCK m_ringsLock;
+
+	HANDLE m_hThread;
+	HANDLE m_hWakeEvent;
+	atomic<bool> m_bStop;
+
+	LARGE_INTEGER m_frequency;
+	LARGE_INTEGER m_startTime;
+	unsigned m_loggerId;        // 스레드 로컬 링 캐시가 이전 로거를 가리키지 않도록 구분
+	string m_batch;             // 로거 스레드만 사용하는 출력 배치 버퍼
+	unordered_map<const LogSite*, unsigned> m_siteIds;   // 바이너리 출력에 이미 기록한 호출 위치
+
+	static atomic<unsigned> s_nextLoggerId;
+
+public:
+	AsyncLogger(HANDLE hOutput, LogFullPolicy policy, bool debugOutput = true, LogOutputFormat format = LogOutputFormat::Text)
+		: m_hOutput(hOutput), m_policy(policy), m_debugOutput(debugOutput && format == LogOutputFormat::Text), m_format(format),
+		m_hThread(NULL), m_hWakeEvent(NULL), m_bStop(false),
+		m_loggerId(s_nextLoggerId.fetch_add(1) + 1)
+	{
+		InitializeSRWLock(&m_ringsLock);
+		QueryPerformanceFrequency(&m_frequency);
+		QueryPerformanceCounter(&m_startTime);
+		m_batch.reserve(64 * 1024);
+	}
+
+	~AsyncLogger()
+	{
+		Stop();
+	}
+
+	bool Start()
+	{
+		if (m_hThread != NULL) return false;
+
+		m_bStop = false;
+		m_hWakeEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+		if (m_hWakeEvent == NULL) return false;
+
+		if (m_format == LogOutputFormat::Binary) {
+			string header(kBinaryLogMagic, sizeof(kBinaryLogMagic));
+			AppendBinary(header, m_frequency.QuadPart);
+			AppendBinary(header, m_startTime.QuadPart);
+			WriteOutput(header);
+		}
+
+		m_hThread = CreateThread(NULL, 0, WriterThreadProc, this, 0, NULL);
+		if (m_hThread == NULL) {
+			CloseHandle(m_hWakeEvent);
+			m_hWakeEvent = NULL;
+			return false;
+		}
+		return true;
+	}
+
+	// 남은 레코드를 모두 출력한 뒤 로거 스레드 종료
+	void Stop()
+	{
+		if (m_hThread == NULL) return;
+
+		m_bStop = true;
+		SetEvent(m_hWakeEvent);
+		WaitForSingleObject(m_hThread, INFINITE);
+		CloseHandle(m_hThread);
+		CloseHandle(m_hWakeEvent);
+		m_hThread = NULL;
+		m_hWakeEvent = NULL;
+	}
+
+	// 워커 스레드에서 호출: 타임스탬프를 찍고 자기 링에 레코드만 넣는다
+	void LogV(const char* fmt, va_list ap)
+	{
+		LogRing* ring = nullptr;
+		LogRecord* record = AcquireRecord(ring);
+		if (record == nullptr) return;
+
+		record->site = nullptr;
+		StringCchVPrintfA(record->text, sizeof(record->text), fmt, ap);
+		record->length = (DWORD)strlen(record->text);
+		ring->CommitWrite();
+	}
+
+	// 지연 포맷: 호출 위치와 인자 원본만 복사하고 포맷은 하지 않는다
+	template <typename... Args>
+	void LogDeferred(const LogSite& site, const Args&... args)
+	{
+		LogRing* ring = nullptr;
+		LogRecord* record = AcquireRecord(ring);
+		if (record == nullptr) return;
+
+		record->site = &site;
+		record->length = (DWORD)EncodeLogArgs(record->text, sizeof(record->text), args...);
+		ring->CommitWrite();
+	}
+
+	// 스레드 풀처럼 스레드가 끝나지 않고 로깅만 멈출 때 호출하면 링을 바로 돌려줌
+	// (다시 로그를 남기면 새 링을 받음). 스레드가 끝날 때는 자동으로 처리됨
+	void ReleaseThreadRing()
+	{
+		ThreadRingHolder& holder = ThreadRing();
+		if (holder.loggerId != m_loggerId) return;
+		holder.ring->Retire();
+		holder.ring.reset();
+		holder.loggerId = 0;
+		if (m_hWakeEvent) SetEvent(m_hWakeEvent);
+	}
+
+private:
+	// 스레드 로컬 링 캐시. 스레드가 끝나면 소멸자가 링을 은퇴시킴
+	// shared_ptr이라 로거가 먼저 사라져도 은퇴 표시가 해제된 메모리를 건드리지 않음
+	struct ThreadRingHolder
+	{
+		shared_ptr<LogRing> ring;
+		unsigned loggerId = 0;
+
+		~ThreadRingHolder() { if (ring) ring->Retire(); }
+	};
+
+	static ThreadRingHolder& ThreadRing()
+	{
+		static thread_local ThreadRingHolder t_holder;
+		return t_holder;
+	}
+
+	// 자기 링에서 빈 레코드를 얻고 타임스탬프/스레드 ID를 채운다. Drop 정책에서 가득 차면 nullptr
+	LogRecord* AcquireRecord(LogRing*& ring)
+	{
+		ring = GetThreadRing();
+		if (ring == nullptr) return nullptr;
+
+		LogRecord* record = ring->BeginWrite();
+		while (record == nullptr) {
+			if (m_policy == LogFullPolicy::Drop) {
+				ring->AddDropped();
+				return nullptr;
+			}
+			// Block: 로거 스레드를 깨우고 자리가 날 때까지 양보
+			SetEvent(m_hWakeEvent);
+			SwitchToThread();
+			record = ring->BeginWrite();
+		}
+
+		LARGE_INTEGER now;
+		QueryPerformanceCounter(&now);
+		record->timestamp = now.QuadPart;
+		record->threadId = ring->GetOwnerThreadId();
+		return record;
+	}
+
+	// 스레드마다 처음 한 번만 링을 등록하고, 이후에는 스레드 로컬 캐시를 사용
+	LogRing* GetThreadRing()
+	{
+		ThreadRingHolder& holder = ThreadRing();
+		if (holder.loggerId == m_loggerId) return holder.ring.get();
+
+		shared_ptr<LogRing> ring(new (nothrow) LogRing(GetCurrentThreadId()));
+		if (!ring) return nullptr;
+
+		AcquireSRWLockExclusive(&m_ringsLock);
+		m_rings.push_back(ring);
+		ReleaseSRWLockExclusive(&m_ringsLock);
+
+		// 다른 로거에 쓰던 링은 은퇴시키고 그 로거가 비운 뒤 해제하게 함
+		if (holder.ring) holder.ring->Retire();
+		holder.ring = std::move(ring);
+		holder.loggerId = m_loggerId;
+		return holder.ring.get();
+	}
+
+	static DWORD WINAPI WriterThreadProc(LPVOID lpParam)
+	{
+		AsyncLogger* logger = static_cast<AsyncLogger*>(lpParam);
+		logger->WriterLoop();
+		return 0;
+	}
+
+	void WriterLoop()
+	{
+		while (true) {
+			if (DrainOnce() > 0) continue;
+
+			// 링이 모두 비었을 때만 종료 요청을 확인해서 남은 로그를 잃지 않음
+			if (m_bStop.load()) {
+				while (DrainOnce() > 0) {}
+				break;
+			}
+			WaitForSingleObject(m_hWakeEvent, 10);
+		}
+	}
+
+	// 모든 링에서 레코드를 꺼내 포맷한 뒤 한 번에 출력. 꺼낸 레코드 수 반환
+	size_t DrainOnce()
+	{
+		size_t drained = 0;
+		bool anyFinished = false;
+
+		AcquireSRWLockShared(&m_ringsLock);
+		for (auto& ring : m_rings) {
+			unsigned long long dropped = ring->TakeDropped();
+			if (dropped > 0) AppendDropped(ring->GetOwnerThreadId(), dropped);
+
+			for (int i = 0; i < kMaxRecordsPerRing; ++i) {
+				const LogRecord* record = ring->BeginRead();
+				if (record == nullptr) break;
+
+				if (m_format == LogOutputFormat::Binary) AppendBinaryRecord(*record);
+				else AppendTextRecord(*record);
+				ring->CommitRead();
+				++drained;
+			}
+			if (ring->IsFinished()) anyFinished = true;
+		}
+		ReleaseSRWLockShared(&m_ringsLock);
+
+		// 끝난 스레드의 링은 다 비운 뒤 목록에서 뺌 (다음 패스부터 순회하지 않음)
+		if (anyFinished) {
+			AcquireSRWLockExclusive(&m_ringsLock);
+			m_rings.erase(remove_if(m_rings.begin(), m_rings.end(),
+				[](const shared_ptr<LogRing>& ring) { return ring->IsFinished(); }), m_rings.end());
+			ReleaseSRWLockExclusive(&m_ringsLock);
+		}
+
+		if (!m_batch.empty()) {
+			WriteOutput(m_batch);
+			if (m_debugOutput) OutputDebugStringA(m_batch.c_str());
+			m_batch.clear();
+		}
+		return drained;
+	}
+
+	void AppendTextRecord(const LogRecord& record)
+	{
+		char prefix[64];
+		double seconds = (double)(record.timestamp - m_startTime.QuadPart) / m_frequency.QuadPart;
+		StringCchPrintfA(prefix, 64, "[%10.6f][%5lu] ", seconds, record.threadId);
+		m_batch += prefix;
+		if (record.site) FormatDeferred(record.site->format, record.text, record.length, m_batch);
+		else m_batch.append(record.text, record.length);
+	}
+
+	void AppendBinaryRecord(const LogRecord& record)
+	{
+		if (record.site == nullptr) {
+			m_batch += (char)kFrameText;
+			AppendBinary(m_batch, record.timestamp);
+			AppendBinary(m_batch, (UINT32)record.threadId);
+			AppendBinary(m_batch, (WORD)record.length);
+			m_batch.append(record.text, record.length);
+			return;
+		}
+
+		// 처음 보는 호출 위치면 포맷 문자열을 한 번만 기록
+		auto found = m_siteIds.find(record.site);
+		UINT32 siteId;
+		if (found == m_siteIds.end()) {
+			siteId = (UINT32)m_siteIds.size();
+			m_siteIds[record.site] = siteId;
+
+			WORD formatLength = (WORD)strlen(record.site->format);
+			WORD fileLength = (WORD)strlen(record.site->file);
+			m_batch += (char)kFrameSite;
+			AppendBinary(m_batch, siteId);
+			AppendBinary(m_batch, (INT32)record.site->line);
+			AppendBinary(m_batch, formatLength);
+			m_batch.append(record.site->format, formatLength);
+			AppendBinary(m_batch, fileLength);
+			m_batch.append(record.site->file, fileLength);
+		}
+		else {
+			siteId = found->second;
+		}
+
+		m_batch += (char)kFrameEntry;
+		AppendBinary(m_batch, siteId);
+		AppendBinary(m_batch, record.timestamp);
+		AppendBinary(m_batch, (UINT32)record.threadId);
+		AppendBinary(m_batch, (WORD)record.length);
+		m_batch.append(record.text, record.length);
+	}
+
+	void AppendDropped(DWORD threadId, unsigned long long dropped)
+	{
+		if (m_format == LogOutputFormat::Binary) {
+			m_batch += (char)kFrameDropped;
+			AppendBinary(m_batch, (UINT32)threadId);
+			AppendBinary(m_batch, (ULONGLONG)dropped);
+			return;
+		}
+
+		char line[128];
+		StringCchPrintfA(line, 128, "[AsyncLogger] 스레드 %lu: 로그 %llu개 유실\r\n", threadId, dropped);
+		m_batch += line;
+	}
+
+	void WriteOutput(const string& data)
+	{
+		DWORD written = 0;
+		if (m_hOutput && m_hOutput != INVALID_HANDLE_VALUE) {
+			WriteFile(m_hOutput, data.data(), (DWORD)data.size(), &written, nullptr);
+		}
+	}
+};
+
+atomic<unsigned> AsyncLogger::s_nextLoggerId(0);
+
+// 설정되어 있으면 Logf가 비동기 로거로 기록한다
+AsyncLogger* g_pAsyncLogger = nullptr;
+
+void Logf(const char* fmt, ...)
+{
+	va_list ap; va_start(ap, fmt);
+	if (g_pAsyncLogger) g_pAsyncLogger->LogV(fmt, ap);
+	else LogfSyncV(fmt, ap);
+	va_end(ap);
+}
+
+// 비동기 로거가 없으면 기존 Logf처럼 바로 포맷해서 출력
+template <typename... Args>
+void LogfDeferred(const LogSite& site, const Args&... args)
+{
+	if (g_pAsyncLogger) g_pAsyncLogger->LogDeferred(site, args...);
+	else Logf(site.format, args...);
+}
+
+// 호출 위치마다 정적 LogSite가 하나씩 생긴다 (상수 초기화라 실행 중 등록 비용 없음)
+#define LOGF_DEFERRED(fmt, ...) \
+	do { \
+		static const LogSite s_logSite = { fmt, __FILE__, __LINE__ }; \
+		LogfDeferred(s_logSite, ##__VA_ARGS__); \
+	} while (0)
+
+// ----------------------------------------------------------------------------
+// 바이너리 로그 디코더: 03_CreateThread.exe --decode <파일>
+// ----------------------------------------------------------------------------
+int DecodeBinaryLog(const char* path)
+{
+	HANDLE hFile = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (hFile == INVALID_HANDLE_VALUE) {
+		cout << "로그 파일을 열 수 없습니다: " << path << " (오류 코드: " << GetLastError() << ")" << endl;
+		return 1;
+	}
+
+	LARGE_INTEGER fileSize;
+	GetFileSizeEx(hFile, &fileSize);
+	vector<char> data((size_t)fileSize.QuadPart);
+	DWORD read = 0;
+	BOOL ok = data.empty() || ReadFile(hFile, data.data(), (DWORD)data.size(), &read, NULL);
+	CloseHandle(hFile);
+
+	const size_t headerSize = sizeof(kBinaryLogMagic) + sizeof(LONGLONG) * 2;
+	if (!ok || read < headerSize || memcmp(data.data(), kBinaryLogMagic, sizeof(kBinaryLogMagic)) != 0) {
+		cout << "바이너리 로그 형식이 아닙니다: " << path << endl;
+		return 1;
+	}
+
+	const char* p = data.data() + sizeof(kBinaryLogMagic);
+	const char* end = data.data() + read;
+	auto take = [&p, end](void* dst, size_t n) {
+		if ((size_t)(end - p) < n) return false;
+		memcpy(dst, p, n);
+		p += n;
+		return true;
+	};
+
+	LONGLONG frequency = 0, startTime = 0;
+	take(&frequency, sizeof(frequency));
+	take(&startTime, sizeof(startTime));
+
+	vector<string> formats;
+	string out;
+	char prefix[64];
+	size_t entries = 0;
+	bool corrupt = false;
+
+	while (p < end) {
+		char frame = *p++;
+		if (frame == kFrameSite) {
+			UINT32 siteId; INT32 line; WORD length;
+			if (!take(&siteId, 4) || !take(&line, 4) || !take(&length, 2) || (size_t)(end - p) < length) break;
+			string format(p, length);
+			p += length;
+			if (!take(&length, 2) || (size_t)(end - p) < length) break;
+			p += length;   // 파일 이름은 출력하지 않음
+			// 기록기는 호출 위치 번호를 0부터 차례로 붙이므로, 지금까지 본 개수보다 큰 번호는 손상된 파일
+			if (siteId > formats.size()) {
+				corrupt = true;
+				break;
+			}
+			if (siteId == formats.size()) formats.push_back(format);
+			else formats[siteId] = format;
+		}
+		else if (frame == kFrameEntry || frame == kFrameText) {
+			UINT32 siteId = 0, threadId; LONGLONG timestamp; WORD length;
+			if (frame == kFrameEntry && !take(&siteId, 4)) break;
+			if (!take(&timestamp, 8) || !take(&threadId, 4) || !take(&length, 2) || (size_t)(end - p) < length) break;
+
+			StringCchPrintfA(prefix, 64, "[%10.6f][%5lu] ", (double)(timestamp - startTime) / frequency, (unsigned long)threadId);
+			out += prefix;
+			if (frame == kFrameText) out.append(p, length);
+			else if (siteId < formats.size()) FormatDeferred(formats[siteId].c_str(), p, length, out);
+			else out += "<알 수 없는 호출 위치>\r\n";
+			p += length;
+			++entries;
+		}
+		else if (frame == kFrameDropped) {
+			UINT32 threadId; ULONGLONG dropped;
+			if (!take(&threadId, 4) || !take(&dropped, 8)) break;
+			StringCchPrintfA(prefix, 64, "[AsyncLogger] 스레드 %lu: 로그 %llu개 유실\r\n", (unsigned long)threadId, dropped);
+			out += prefix;
+		}
+		else {
+			cout << "알 수 없는 프레임 종류: " << (int)frame << endl;
+			break;
+		}
+	}
+
+	cout << out;
+	if (corrupt) {
+		cout << "\n손상된 로그 파일: 호출 위치 번호가 범위를 벗어남 (레코드 " << entries << "개까지 디코딩)" << endl;
+		return 1;
+	}
+	cout << "\n디코딩 완료: 레코드 " << entries << "개, 호출 위치 " << formats.size() << "개" << endl;
+	return 0;
+}
+
 // 반드시 WINAPI 규약
 DWORD WINAPI WorkerThread(LPVOID lpParam)
 {
 	ThreadData* data = static_cast<ThreadData*>(lpParam);
 
-	Logf("WorkerThread 시작 - ID:%d %s\r\n", data->threadId, data->message);
+	LOGF_DEFERRED("WorkerThread 시작 - ID:%d %s\r\n", data->threadId, data->message);
 
 	for (int i = 1; i <= data->count; ++i) {
-		Logf("스레드 %d: 작업 %d/%d 수행 중...\r\n",
+		LOGF_DEFERRED("스레드 %d: 작업 %d/%d 수행 중...\r\n",
 			data->threadId, i, data->count);
 		Sleep(1000);
 	}
 
-	Logf("스레드 %d: 모든 작업 완료!\r\n", data->threadId);
+	LOGF_DEFERRED("스레드 %d: 모든 작업 완료!\r\n", data->threadId);
 	return data->threadId * 100;
 }
 
-int main()
+// ============================================================================
+// 로그 호출 지연 시간 벤치마크
+// ============================================================================
+// 워커 스레드 입장에서 Logf 한 번이 얼마나 걸리는지(호출 측 지연)를 측정합니다.
+// 동기 Logf, 비동기 로거(Drop), 비동기 로거(Block)를 같은 호출 코드로 비교합니다.
+
+// 벤치마크에서 측정할 로그 호출 한 번
+typedef void (*LogBenchCall)(int threadIndex, int step, int total);
+
+void LogBenchPrintf(int threadIndex, int step, int total)
+{
+	Logf("벤치 스레드 %d: 작업 %d/%d 수행 중...\r\n", threadIndex, step, total);
+}
+
+void LogBenchDeferred(int threadIndex, int step, int total)
+{
+	LOGF_DEFERRED("벤치 스레드 %d: 작업 %d/%d 수행 중...\r\n", threadIndex, step, total);
+}
+
+struct LogBenchParams {
+	int threadIndex;
+	int messageCount;
+	LogBenchCall call;
+	vector<LONGLONG>* latencies;   // QPC 틱 단위
+};
+
+DWORD WINAPI LogBenchThread(LPVOID lpParam)
+{
+	LogBenchParams* params = static_cast<LogBenchParams*>(lpParam);
+	LARGE_INTEGER before, after;
+
+	for (int i = 0; i < params->messageCount; ++i) {
+		QueryPerformanceCounter(&before);
+		params->call(params->threadIndex, i + 1, params->messageCount);
+		QueryPerformanceCounter(&after);
+		(*params->latencies)[i] = after.QuadPart - before.QuadPart;
+	}
+	return 0;
+}
+
+// 결과 한 줄을 반환 (비동기 출력과 섞이지 않도록 마지막에 한꺼번에 출력)
+string RunLogBench(const char* label, int threadCount, int messagesPerThread, LogBenchCall call = LogBenchPrintf)
+{
+	vector<vector<LONGLONG>> latencies(threadCount, vector<LONGLONG>(messagesPerThread));
+	vector<LogBenchParams> params(threadCount);
+	vector<HANDLE> threads;
+
+	for (int i = 0; i < threadCount; ++i) {
+		params[i] = { i + 1, messagesPerThread, call, &latencies[i] };
+		HANDLE hThread = CreateThread(nullptr, 0, LogBenchThread, &params[i], 0, nullptr);
+		if (hThread) threads.push_back(hThread);
+	}
+	WaitForMultipleObjects((DWORD)threads.size(), threads.data(), TRUE, INFINITE);
+	for (auto h : threads) CloseHandle(h);
+
+	vector<LONGLONG> all;
+	for (auto& v : latencies) all.insert(all.end(), v.begin(), v.end());
+	sort(all.begin(), all.end());
+
+	LARGE_INTEGER freq;
+	QueryPerformanceFrequency(&freq);
+	auto toNs = [&freq](LONGLONG ticks) { return (double)ticks * 1e9 / freq.QuadPart; };
+
+	double sum = 0;
+	for (auto t : all) sum += toNs(t);
+
+	char line[256];
+	StringCchPrintfA(line, 256, "%-16s avg %10.0f ns | p50 %10.0f ns | p99 %10.0f ns | max %12.0f ns\r\n",
+		label, sum / all.size(), toNs(all[all.size() / 2]), toNs(all[all.size() * 99 / 100]), toNs(all.back()));
+	return line;
+}
+
+void BenchmarkLogLatency()
 {
+	const int threadCount = 4;
+	const int messagesPerThread = 2000;
+
+	cout << "=== Logf 호출 지연 벤치마크 (" << threadCount << " 스레드 x " << messagesPerThread << "회) ===" << endl;
+
+	string report;
+	g_pAsyncLogger = nullptr;
+	report += RunLogBench("sync Logf", threadCount, messagesPerThread);
+
+	{
+		AsyncLogger logger(GetStdHandle(STD_OUTPUT_HANDLE), LogFullPolicy::Drop, false);
+		logger.Start();
+		g_pAsyncLogger = &logger;
+		report += RunLogBench("async (Drop)", threadCount, messagesPerThread);
+		g_pAsyncLogger = nullptr;
+		logger.Stop();
+	}
+
+	{
+		AsyncLogger logger(GetStdHandle(STD_OUTPUT_HANDLE), LogFullPolicy::Block, false);
+		logger.Start();
+		g_pAsyncLogger = &logger;
+		report += RunLogBench("async (Block)", threadCount, messagesPerThread);
+		g_pAsyncLogger = nullptr;
+		logger.Stop();
+	}
+
+	// 지연 포맷 비교: 출력 핸들 없이 호출 측 비용만 측정 (콘솔 속도 영향 제거)
+	{
+		AsyncLogger logger(NULL, LogFullPolicy::Block, false);
+		logger.Start();
+		g_pAsyncLogger = &logger;
+		report += RunLogBench("printf-style", threadCount, messagesPerThread, LogBenchPrintf);
+		report += RunLogBench("deferred (text)", threadCount, messagesPerThread, LogBenchDeferred);
+		g_pAsyncLogger = nullptr;
+		logger.Stop();
+	}
+
+	{
+		AsyncLogger logger(NULL, LogFullPolicy::Block, false, LogOutputFormat::Binary);
+		logger.Start();
+		g_pAsyncLogger = &logger;
+		report += RunLogBench("deferred (bin)", threadCount, messagesPerThread, LogBenchDeferred);
+		g_pAsyncLogger = nullptr;
+		logger.Stop();
+	}
+
+	cout << "\n=== 호출 측 지연 시간 (호출 1회당) ===" << endl;
+	cout << report;
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc > 1 && strcmp(argv[1], "--bench-log") == 0) {
+		BenchmarkLogLatency();
+		return 0;
+	}
+	if (argc > 2 && strcmp(argv[1], "--decode") == 0) {
+		return DecodeBinaryLog(argv[2]);
+	}
+
 	cout << "CreateThread 예제입니다" << endl;
 
+	// --binary-log <파일>: 워커 로그를 포맷하지 않고 바이너리로 저장 (--decode로 확인)
+	HANDLE hLogOutput = GetStdHandle(STD_OUTPUT_HANDLE);
+	LogOutputFormat logFormat = LogOutputFormat::Text;
+	if (argc > 2 && strcmp(argv[1], "--binary-log") == 0) {
+		hLogOutput = CreateFileA(argv[2], GENERIC_WRITE, FILE_SHARE_READ, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (hLogOutput == INVALID_HANDLE_VALUE) {
+			cout << "로그 파일 생성 실패! 오류 코드: " << GetLastError() << endl;
+			return 1;
+		}
+		logFormat = LogOutputFormat::Binary;
+	}
+
+	// 워커의 Logf는 비동기 로거로 보내고, 콘솔 출력은 로거 스레드가 담당
+	AsyncLogger logger(hLogOutput, LogFullPolicy::Block, true, logFormat);
+	logger.Start();
+	g_pAsyncLogger = &logger;
+
 	const int threadSize = 2;
 	vector<ThreadData> threadDatas = {
 		{1, "첫 번째 워커 스레드", 3},
@@ -97,6 +993,14 @@ int main()
 		INFINITE
 	);
 
+	// 워커 로그를 모두 출력하고 로거 종료
+	g_pAsyncLogger = nullptr;
+	logger.Stop();
+	if (logFormat == LogOutputFormat::Binary) {
+		CloseHandle(hLogOutput);
+		cout << "바이너리 로그 저장 완료: " << argv[2] << endl;
+	}
+
 	if (wr == WAIT_OBJECT_0) {
 		cout << "모든 스레드가 완료 상태가 되었습니다.\n";
 		for (int i = 0; i < threadSize; ++i) {
@@ -1,19 +1,100 @@
 ﻿#include <windows.h>
 #include <iostream>
 #include <process.h>
+#include <memory>
+#include <vector>
+#include <cstring>
+#include <cstdlib>
+#include <strsafe.h>
+#include <cerrno>
+#include <functional>
+#include <algorithm>
 
-// C++에서의 스레드 생성 방법
+#include "../Common/StopToken.h"   // StopSource / StopToken
+
+// WaitOnAddress / WakeByAddressAll (Windows 8 이상)
+#pragma comment(lib, "Synchronization.lib")
+
+// ============================================================================
+// 유휴 대기 정책: spin → yield → park
+// ============================================================================
+// 작업이 없을 때 바로 잠들면(park) CPU는 아끼지만 다시 깨우는 데 수 us가 걸리고,
+// 계속 돌면(spin) 지연은 가장 짧지만 코어 하나를 차지합니다.
+// 정해진 횟수만큼 spin, 그다음 yield를 해 보고 그래도 일이 없으면 잠듭니다.
+struct IdlePolicy
+{
+	DWORD spinCount;    // YieldProcessor(pause)로 바쁘게 기다리는 횟수
+	DWORD yieldCount;   // SwitchToThread로 다른 스레드에 양보하는 횟수
+};
+
+const IdlePolicy kIdleParkOnly = { 0, 0 };
+const IdlePolicy kIdleYield = { 0, 200 };
+const IdlePolicy kIdleSpin = { 200000, 0 };
+const IdlePolicy kIdleAdaptive = { 4000, 50 };
+
+// *address 값이 oldValue에서 바뀔 때까지 spin/yield 단계까지만 기다린다. 바뀌었으면 true
+inline bool SpinWhileEqual(volatile LONG* address, LONG oldValue, const IdlePolicy& policy)
+{
+	for (DWORD i = 0; i < policy.spinCount; ++i) {
+		if (*address != oldValue) return true;
+		YieldProcessor();
+	}
+	for (DWORD i = 0; i < policy.yieldCount; ++i) {
+		if (*address != oldValue) return true;
+		SwitchToThread();
+	}
+	return *address != oldValue;
+}
+
+// spin/yield 후에도 바뀌지 않으면 WaitOnAddress로 잠든다
+inline void WaitWhileEqual(volatile LONG* address, LONG oldValue, const IdlePolicy& policy)
+{
+	if (SpinWhileEqual(address, oldValue, policy)) return;
+	while (*address == oldValue) {
+		WaitOnAddress(address, &oldValue, sizeof(LONG), INFINITE);
+	}
+}
+
+// ============================================================================
+// 오래 살아 있는 워커: 스레드는 한 번만 만들고 작업을 우편함(mailbox)으로 받는다
+// ============================================================================
+// Post(fn)은 작업을 넣고 바로 반환, PostAndWait(fn)는 작업이 끝날 때까지 기다립니다.
+// Stop()은 새 작업을 더 받지 않고, 이미 들어온 작업을 모두 실행한 뒤 스레드를 종료합니다.
 class ThreadWorker
 {
+public:
+	typedef std::function<void()> Task;
+
 private:
 	int m_workerId;
-	bool m_bStop;
+	IdlePolicy m_idlePolicy;
+	int m_cpuIndex;                  // 0 이상이면 해당 논리 CPU에 고정
+	StopSource m_stopSource;
 	HANDLE m_hThread;
 	unsigned m_threadId;
 
+	SRWLOCK m_queueLock;
+	std::vector<Task> m_pending;     // m_queueLock으로 보호
+	bool m_accepting;                // m_queueLock으로 보호. false면 Post 거부
+
+	volatile LONG m_postSeq;         // Post마다 증가. 워커는 이 값의 변화를 기다린다
+	volatile LONG m_parked;          // 워커가 WaitOnAddress로 잠들어 있으면 1
+	volatile LONG m_parkCount;       // 통계: 잠든 횟수
+
 public:
-	ThreadWorker(int workerId) : m_workerId(workerId), m_bStop(false), m_hThread(NULL), m_threadId(0) {}
-	
+	ThreadWorker(int workerId, const IdlePolicy& idlePolicy = kIdleAdaptive, int cpuIndex = -1)
+		: m_workerId(workerId), m_idlePolicy(idlePolicy), m_cpuIndex(cpuIndex),
+		m_hThread(NULL), m_threadId(0), m_accepting(false),
+		m_postSeq(0), m_parked(0), m_parkCount(0)
+	{
+		InitializeSRWLock(&m_queueLock);
+
+		// CPU가 하나뿐이면 spin하는 동안 상대 스레드가 실행될 수 없으므로 spin 단계를 건너뜀
+		SYSTEM_INFO si;
+		GetSystemInfo(&si);
+		if (si.dwNumberOfProcessors < 2) m_idlePolicy.spinCount = 0;
+	}
+
 	~ThreadWorker()
 	{
 		Stop();
@@ -23,44 +104,139 @@ public:
 	{
 		if (m_hThread != NULL) return false; // 이미 스레드가 실행 중임
 
-		m_bStop = false;
+		m_stopSource = StopSource();   // 이전 실행의 중지 요청이 남지 않도록 새 상태로 시작
+		m_accepting = true;
 		m_hThread = reinterpret_cast<HANDLE>(_beginthreadex(
 			NULL,               // 보안 속성
 			0,                  // 기본 스택 크기
 			ThreadProc,        // 스레드 함수
 			this,              // 스레드 함수에 전달할 인자
-			0,                  // 즉시 실행
+			CREATE_SUSPENDED,   // CPU 고정을 먼저 하고 실행
 			&m_threadId));     // 스레드 ID
-		return m_hThread != NULL;
+		if (m_hThread == NULL) {
+			m_accepting = false;
+			return false;
+		}
+
+		if (m_cpuIndex >= 0) {
+			DWORD_PTR mask = (DWORD_PTR)1 << m_cpuIndex;
+			if (SetThreadAffinityMask(m_hThread, mask) == 0) {
+				std::cout << "워커 " << m_workerId << ": CPU " << m_cpuIndex << " 고정 실패 (오류 코드: " << GetLastError() << ")" << std::endl;
+			}
+		}
+		ResumeThread(m_hThread);
+		return true;
 	}
 
 	void Stop()
 	{
 		if (m_hThread == NULL) return;
 
-		m_bStop = true;
+		AcquireSRWLockExclusive(&m_queueLock);
+		m_accepting = false;
+		ReleaseSRWLockExclusive(&m_queueLock);
+
+		m_stopSource.RequestStop();
+		Notify();   // 잠든 워커를 깨워서 중지 요청을 확인하게 함
+
 		WaitForSingleObject(m_hThread, INFINITE);
 		CloseHandle(m_hThread);
 		m_hThread = NULL;
 		m_threadId = 0;
 	}
 
+	// 작업을 넣고 바로 반환. 워커가 실행 중이 아니면 false
+	bool Post(Task task)
+	{
+		AcquireSRWLockExclusive(&m_queueLock);
+		if (!m_accepting) {
+			ReleaseSRWLockExclusive(&m_queueLock);
+			return false;
+		}
+		m_pending.push_back(std::move(task));
+		ReleaseSRWLockExclusive(&m_queueLock);
+
+		Notify();
+		return true;
+	}
+
+	// 작업이 워커에서 끝날 때까지 기다린다. 워커 자신이 호출하면 그 자리에서 실행
+	bool PostAndWait(Task task)
+	{
+		if (GetCurrentThreadId() == m_threadId) {
+			task();
+			return true;
+		}
+
+		volatile LONG done = 0;
+		bool posted = Post([&task, &done]() {
+			task();
+			InterlockedExchange(&done, 1);
+			WakeByAddressSingle((PVOID)&done);
+		});
+		if (!posted) return false;
+
+		WaitWhileEqual(&done, 0, m_idlePolicy);
+		return true;
+	}
+
+	// 오래 걸리는 작업이 Stop()에 바로 반응하도록 쓰는 토큰
+	StopToken GetStopToken() const { return m_stopSource.GetToken(); }
+
+	LONG GetParkCount() const { return m_parkCount; }
+
 private:
+	void Notify()
+	{
+		// 증가(전체 메모리 배리어) 후 m_parked를 읽으므로, 워커가 잠들기 직전이라도
+		// 둘 중 하나는 반드시 상대의 변경을 보게 된다
+		InterlockedIncrement(&m_postSeq);
+		if (m_parked) WakeByAddressSingle((PVOID)&m_postSeq);
+	}
+
 	static unsigned __stdcall ThreadProc(void* pParam)
 	{
 		ThreadWorker* worker = static_cast<ThreadWorker*>(pParam);
-		return worker->WorkerFunction();
+		return worker->WorkerFunction(worker->m_stopSource.GetToken());
 	}
 
-	unsigned WorkerFunction()
+	// 쌓인 작업을 한꺼번에 꺼내서 실행. 실행한 작업이 있으면 true
+	bool RunPendingTasks(std::vector<Task>& batch)
+	{
+		AcquireSRWLockExclusive(&m_queueLock);
+		batch.swap(m_pending);
+		ReleaseSRWLockExclusive(&m_queueLock);
+
+		if (batch.empty()) return false;
+		for (Task& task : batch) task();
+		batch.clear();
+		return true;
+	}
+
+	unsigned WorkerFunction(StopToken token)
 	{
 		std::cout << "워커 " << m_workerId << " 시작 (스레드 ID: " << m_threadId << ")" << std::endl;
 
-		int iteration = 0;
-		while (!m_bStop && iteration < 10)
+		std::vector<Task> batch;
+		while (true)
 		{
-			std::cout << "워커 " << m_workerId << " 작업 중... " << ++iteration << std::endl;
-			Sleep(500);
+			LONG seen = m_postSeq;   // 큐를 확인하기 전에 읽어야 그 사이의 Post를 놓치지 않음
+			if (RunPendingTasks(batch)) continue;
+
+			if (token.StopRequested()) {
+				// Stop()이 m_accepting을 먼저 내렸으므로 남은 작업만 비우면 끝
+				while (RunPendingTasks(batch)) {}
+				break;
+			}
+
+			if (SpinWhileEqual(&m_postSeq, seen, m_idlePolicy)) continue;
+
+			InterlockedExchange(&m_parked, 1);
+			InterlockedIncrement(&m_parkCount);
+			while (m_postSeq == seen) {
+				WaitOnAddress(&m_postSeq, &seen, sizeof(LONG), INFINITE);
+			}
+			InterlockedExchange(&m_parked, 0);
 		}
 
 		std::cout << "워커 " << m_workerId << " 종료" << std::endl;
@@ -77,14 +253,216 @@ void DemonstrateThreadSafeWorker()
 	if (worker.Start())
 	{
 		std::cout << "워커 시작됨" << std::endl;
+
+		// 결과가 필요한 작업은 PostAndWait로 워커에서 실행하고 기다림
+		long long sum = 0;
+		worker.PostAndWait([&sum]() {
+			for (int i = 1; i <= 1000; ++i) sum += i;
+		});
+		std::cout << "PostAndWait 결과: 1~1000 합 = " << sum << std::endl;
+
+		// 오래 걸리는 작업은 Post로 넘기고, 중지 토큰으로 Stop()에 바로 반응하게 함
+		StopToken token = worker.GetStopToken();
+		worker.Post([token]() {
+			for (int iteration = 1; iteration <= 10; ++iteration) {
+				std::cout << "워커 100 작업 중... " << iteration << std::endl;
+				if (!token.SleepFor(500)) break;   // 중지 요청이 오면 바로 깨어남
+			}
+		});
+
 		Sleep(3000);  // 3초 후 종료
+
+		LARGE_INTEGER freq, before, after;
+		QueryPerformanceFrequency(&freq);
+		QueryPerformanceCounter(&before);
 		worker.Stop();
-		std::cout << "워커 정리 완료\n" << std::endl;
+		QueryPerformanceCounter(&after);
+
+		std::cout << "워커 정리 완료 (Stop 소요 시간: "
+			<< (after.QuadPart - before.QuadPart) * 1000000 / freq.QuadPart << " us)\n" << std::endl;
 	}
 }
 
-int main()
+// ============================================================================
+// 중지 지연 벤치마크: 워커 1,000개를 한 번에 멈추는 데 걸리는 시간
+// ============================================================================
+struct StopBenchParams
 {
+	StopToken token;
+	bool usePolling;          // true: 기존 방식 (Sleep 후 플래그 확인)
+	DWORD interval;           // 작업 사이 대기 시간 (ms)
+	LONGLONG stoppedAt;       // 워커가 중지를 확인한 시각 (QPC)
+};
+
+unsigned __stdcall StopBenchWorker(void* pParam)
+{
+	StopBenchParams* params = static_cast<StopBenchParams*>(pParam);
+
+	if (params->usePolling) {
+		while (!params->token.StopRequested()) Sleep(params->interval);
+	}
+	else {
+		while (params->token.SleepFor(params->interval)) {}
+	}
+
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+	params->stoppedAt = now.QuadPart;
+	return 0;
+}
+
+void RunStopBench(const char* label, int workerCount, bool usePolling, DWORD interval)
+{
+	StopSource source;
+	std::vector<StopBenchParams> params(workerCount);
+	std::vector<HANDLE> threads;
+	threads.reserve(workerCount);
+
+	for (int i = 0; i < workerCount; ++i) {
+		params[i].token = source.GetToken();
+		params[i].usePolling = usePolling;
+		params[i].interval = interval;
+		params[i].stoppedAt = 0;
+
+		// 워커가 많으므로 스택 예약 크기를 64KB로 줄인다
+		HANDLE hThread = reinterpret_cast<HANDLE>(_beginthreadex(
+			NULL, 64 * 1024, StopBenchWorker, &params[i], STACK_SIZE_PARAM_IS_A_RESERVATION, NULL));
+		if (hThread == NULL) {
+			std::cout << i << "번째 워커 생성 실패! errno: " << errno << std::endl;
+			break;
+		}
+		threads.push_back(hThread);
+	}
+
+	Sleep(interval + 100);   // 모든 워커가 대기 상태에 들어가도록 기다림
+
+	LARGE_INTEGER freq, requestTime, joinedTime;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&requestTime);
+	source.RequestStop();
+	// WaitForMultipleObjects는 최대 64개까지만 받으므로 하나씩 기다림
+	for (HANDLE h : threads) WaitForSingleObject(h, INFINITE);
+	QueryPerformanceCounter(&joinedTime);
+
+	double sumUs = 0, maxUs = 0;
+	for (size_t i = 0; i < threads.size(); ++i) {
+		double us = (double)(params[i].stoppedAt - requestTime.QuadPart) * 1e6 / freq.QuadPart;
+		sumUs += us;
+		if (us > maxUs) maxUs = us;
+		CloseHandle(threads[i]);
+	}
+
+	double totalUs = (double)(joinedTime.QuadPart - requestTime.QuadPart) * 1e6 / freq.QuadPart;
+	char line[256];
+	StringCchPrintfA(line, 256, "%-22s 워커 %4zu개 | 평균 깨어남 %10.1f us | 최대 %10.1f us | 전체 join %10.1f us",
+		label, threads.size(), threads.empty() ? 0.0 : sumUs / threads.size(), maxUs, totalUs);
+	std::cout << line << std::endl;
+}
+
+void BenchmarkStopLatency()
+{
+	const int workerCount = 1000;
+	const DWORD interval = 500;
+
+	std::cout << "=== 워커 " << workerCount << "개 중지 지연 벤치마크 (대기 간격 " << interval << "ms) ===" << std::endl;
+	RunStopBench("Sleep + 플래그 확인", workerCount, true, interval);
+	RunStopBench("StopToken::SleepFor", workerCount, false, interval);
+}
+
+// ============================================================================
+// 작업 전달 지연 벤치마크: 유휴 정책별 PostAndWait 왕복 시간과 Post 처리량
+// ============================================================================
+unsigned __stdcall EmptyThreadProc(void*)
+{
+	return 0;
+}
+
+void RunDispatchBench(const char* label, const IdlePolicy& policy, int cpuIndex)
+{
+	const int pingCount = 20000;
+	const int postCount = 1000000;
+
+	ThreadWorker worker(200, policy, cpuIndex);
+	if (!worker.Start()) {
+		std::cout << label << ": 워커 시작 실패" << std::endl;
+		return;
+	}
+
+	LARGE_INTEGER freq;
+	QueryPerformanceFrequency(&freq);
+	auto toUs = [&freq](LONGLONG ticks) { return (double)ticks * 1e6 / freq.QuadPart; };
+
+	// 1) 왕복 지연: 매번 워커가 유휴 상태로 돌아간 뒤 다음 작업이 도착
+	long long counter = 0;
+	std::vector<LONGLONG> latencies(pingCount);
+	LONG parksBefore = worker.GetParkCount();
+	for (int i = 0; i < pingCount; ++i) {
+		LARGE_INTEGER before, after;
+		QueryPerformanceCounter(&before);
+		worker.PostAndWait([&counter]() { ++counter; });
+		QueryPerformanceCounter(&after);
+		latencies[i] = after.QuadPart - before.QuadPart;
+	}
+	LONG pingParks = worker.GetParkCount() - parksBefore;
+	std::sort(latencies.begin(), latencies.end());
+
+	// 2) 처리량: 작은 작업 100만 개를 연속으로 Post
+	LARGE_INTEGER start, end;
+	QueryPerformanceCounter(&start);
+	for (int i = 0; i < postCount; ++i) {
+		worker.Post([&counter]() { ++counter; });
+	}
+	worker.PostAndWait([]() {});
+	QueryPerformanceCounter(&end);
+
+	worker.Stop();
+
+	char line[256];
+	StringCchPrintfA(line, 256, "%-10s 왕복 p50 %8.2f us | p99 %8.2f us | park %6ld회 | Post 처리량 %6.2f M/s",
+		label, toUs(latencies[pingCount / 2]), toUs(latencies[pingCount * 99 / 100]), pingParks,
+		postCount / toUs(end.QuadPart - start.QuadPart));
+	std::cout << line << std::endl;
+}
+
+void BenchmarkDispatchLatency(int cpuIndex)
+{
+	std::cout << "=== 작업 전달 지연 벤치마크";
+	if (cpuIndex >= 0) std::cout << " (워커 CPU " << cpuIndex << " 고정)";
+	std::cout << " ===" << std::endl;
+
+	RunDispatchBench("park", kIdleParkOnly, cpuIndex);
+	RunDispatchBench("yield", kIdleYield, cpuIndex);
+	RunDispatchBench("spin", kIdleSpin, cpuIndex);
+	RunDispatchBench("adaptive", kIdleAdaptive, cpuIndex);
+
+	// 비교: 작업마다 스레드를 새로 만들고 기다리는 기존 방식
+	const int threadCount = 2000;
+	LARGE_INTEGER freq, start, end;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&start);
+	for (int i = 0; i < threadCount; ++i) {
+		HANDLE hThread = reinterpret_cast<HANDLE>(_beginthreadex(NULL, 0, EmptyThreadProc, NULL, 0, NULL));
+		if (hThread == NULL) break;
+		WaitForSingleObject(hThread, INFINITE);
+		CloseHandle(hThread);
+	}
+	QueryPerformanceCounter(&end);
+	std::cout << "작업마다 _beginthreadex + 대기: 평균 "
+		<< (double)(end.QuadPart - start.QuadPart) * 1e6 / freq.QuadPart / threadCount << " us" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc > 1 && strcmp(argv[1], "--bench-stop") == 0) {
+		BenchmarkStopLatency();
+		return 0;
+	}
+	// --bench-dispatch [CPU 번호]: 워커를 해당 CPU에 고정해서 측정
+	if (argc > 1 && strcmp(argv[1], "--bench-dispatch") == 0) {
+		BenchmarkDispatchLatency(argc > 2 ? atoi(argv[2]) : -1);
+		return 0;
+	}
+
 	DemonstrateThreadSafeWorker();
 	return 0;
-}
\ No newline at end of file
+}
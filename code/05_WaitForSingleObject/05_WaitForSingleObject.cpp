@@ -4,6 +4,20 @@
 #include <string>
 #include <process.h>
 #include <random>
+#include <functional>
+#include <deque>
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <memory>
+#include <atomic>
+#include <utility>
+#include <strsafe.h>
+
+#include "../Common/StopToken.h"   // StopSource / StopToken
+
+// WaitOnAddress / WakeByAddressAll (Windows 8 이상)
+#pragma comment(lib, "Synchronization.lib")
 
 // 작업 유형별 스레드 함수들 
 unsigned __stdcall FastWorker(void* param)
@@ -42,139 +56,875 @@ unsigned __stdcall UnpredictableWorker(void* param)
 	return 300 + id;
 }
 
-void DemonstrateSingleObjectWait()
+// ============================================================================
+// 계층형 타이머 휠 (hierarchical timer wheel)
+// ============================================================================
+// 상태 확인을 위해 대기하는 쪽마다 WaitForSingleObject(h, 1000) 루프를 돌리면
+// 대기 수만큼 스레드가 필요합니다. TimerWheel은 스레드 하나로 모든 타임아웃과
+// 주기 콜백을 처리하고, 등록/취소는 연결 리스트 조작뿐이라 O(1)입니다.
+//
+//   레벨 0: 256칸 x 1틱      (~256ms)
+//   레벨 1:  64칸 x 256틱    (~16초)
+//   레벨 2:  64칸 x 16384틱  (~17분)
+//   레벨 3:  64칸 x 2^20틱   (~18시간)
+// 상위 레벨 칸은 시간이 그 구간에 들어오면 아래 레벨로 내려보냅니다(cascade).
+// 18시간보다 긴 타이머(DWORD 최대 ~49일)는 만료 시각을 그대로 둔 채 레벨 3에 넣어 두고,
+// 그 칸이 cascade될 때마다 남은 시간을 다시 계산해 범위 안에 들어오면 제자리로 내려갑니다.
+
+typedef ULONGLONG TimerId;   // 상위 32비트: 세대, 하위 32비트: 노드 번호. 0은 무효
+
+class TimerWheel
 {
-	std::cout << "=== WaitForSingleObject 데모 (_beginthreadex 사용) ===" << std::endl;
+public:
+	typedef std::function<void()> Callback;
 
-	int workerId = 1;
-	unsigned threadId;
+private:
+	static const int kLevelCount = 4;
+	static const int kLevel0Bits = 8;
+	static const int kLevelBits = 6;
+	static const DWORD kLevel0Size = 1 << kLevel0Bits;
+	static const DWORD kLevelSize = 1 << kLevelBits;
+	static const ULONGLONG kMaxDelay = (1ull << (kLevel0Bits + kLevelBits * (kLevelCount - 1))) - 1;
 
-	// _beginthreadex로 스레드 생성하고 핸들 얻기
-	HANDLE hThread = reinterpret_cast<HANDLE>(_beginthreadex(
-		NULL,           // 보안 속성
-		0,              // 스택 크기 (기본값)
-		SlowWorker,     // 스레드 함수
-		&workerId,      // 매개변수
-		0,              // 생성 플래그
-		&threadId       // 스레드 ID
-	));
+	enum NodeState { kFree, kArmed, kFiring, kCancelled };
 
-	if (hThread == NULL)
+	struct TimerNode
 	{
-		std::cout << "스레드 생성 실패! 오류 코드: " << GetLastError() << std::endl;
-		return;
+		Callback callback;
+		ULONGLONG expireTick;
+		DWORD period;          // 0이면 1회용
+		DWORD generation;
+		DWORD index;
+		NodeState state;
+		int level;
+		DWORD slot;
+		TimerNode* prev;
+		TimerNode* next;
+	};
+
+	CRITICAL_SECTION m_cs;
+	CONDITION_VARIABLE m_callbackDone;        // m_running 콜백이 끝날 때마다 깨움
+	TimerNode* m_running;                     // 지금 콜백을 실행 중인 노드
+	DWORD m_serviceThreadId;
+	std::deque<TimerNode> m_nodes;            // deque라서 push_back해도 노드 주소가 바뀌지 않음
+	std::vector<DWORD> m_freeNodes;
+	std::vector<TimerNode*> m_slots[kLevelCount];
+	ULONGLONG m_occupied[kLevelCount][kLevel0Size / 64];   // 칸이 비어 있지 않으면 비트 1
+	ULONGLONG m_currentTick;                  // 다음에 처리할 틱
+	ULONGLONG m_plannedWakeTick;              // 서비스 스레드가 깨어나기로 한 틱
+	size_t m_armedCount;
+
+	LARGE_INTEGER m_frequency;
+	LARGE_INTEGER m_startTime;
+	HANDLE m_hThread;
+	HANDLE m_hWakeEvent;
+	volatile LONG m_bStop;
+
+public:
+	TimerWheel() : m_running(nullptr), m_serviceThreadId(0), m_currentTick(0), m_plannedWakeTick(ULLONG_MAX),
+		m_armedCount(0), m_hThread(NULL), m_hWakeEvent(NULL), m_bStop(0)
+	{
+		InitializeCriticalSection(&m_cs);
+		InitializeConditionVariable(&m_callbackDone);
+		for (int level = 0; level < kLevelCount; ++level) {
+			m_slots[level].assign(level == 0 ? kLevel0Size : kLevelSize, nullptr);
+		}
+		memset(m_occupied, 0, sizeof(m_occupied));
+		QueryPerformanceFrequency(&m_frequency);
+		QueryPerformanceCounter(&m_startTime);
 	}
 
-	std::cout << "스레드 작업 중... 2초마다 상태 확인" << std::endl;
+	~TimerWheel()
+	{
+		Stop();
+		DeleteCriticalSection(&m_cs);
+	}
 
-	while (true)
+	bool Start()
 	{
-		DWORD waitResult = WaitForSingleObject(hThread, 2000);  // 2초 대기
+		if (m_hThread != NULL) return false;
 
-		switch (waitResult)
-		{
-		case WAIT_OBJECT_0:
-			std::cout << "스레드 완료!" << std::endl;
+		m_bStop = 0;
+		m_hWakeEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+		if (m_hWakeEvent == NULL) return false;
 
-			DWORD exitCode;
-			if (GetExitCodeThread(hThread, &exitCode))
-			{
-				std::cout << "종료 코드: " << exitCode << std::endl;
+		m_hThread = reinterpret_cast<HANDLE>(_beginthreadex(NULL, 0, ServiceThreadProc, this, 0, NULL));
+		if (m_hThread == NULL) {
+			CloseHandle(m_hWakeEvent);
+			m_hWakeEvent = NULL;
+			return false;
+		}
+		return true;
+	}
+
+	// 아직 발생하지 않은 타이머는 버리고 서비스 스레드 종료
+	void Stop()
+	{
+		if (m_hThread == NULL) return;
+
+		InterlockedExchange(&m_bStop, 1);
+		SetEvent(m_hWakeEvent);
+		WaitForSingleObject(m_hThread, INFINITE);
+		CloseHandle(m_hThread);
+		CloseHandle(m_hWakeEvent);
+		m_hThread = NULL;
+		m_hWakeEvent = NULL;
+	}
+
+	// delayMs 뒤에 한 번 호출
+	TimerId AddTimeout(DWORD delayMs, Callback callback)
+	{
+		return AddTimer(delayMs, 0, std::move(callback));
+	}
+
+	// intervalMs마다 반복 호출 (Cancel할 때까지)
+	TimerId AddPeriodic(DWORD intervalMs, Callback callback)
+	{
+		return AddTimer(intervalMs, intervalMs > 0 ? intervalMs : 1, std::move(callback));
+	}
+
+	// 앞으로의 호출을 막았으면 true. 콜백 안에서 자기 자신을 취소해도 됨
+	// 다른 스레드에서 호출했고 그 콜백이 실행 중이면 끝날 때까지 기다린 뒤 반환하므로,
+	// 반환 후에는 콜백이 캡처한 자원을 해제해도 안전함
+	bool Cancel(TimerId id)
+	{
+		DWORD index = (DWORD)(id & 0xFFFFFFFF);
+		DWORD generation = (DWORD)(id >> 32);
+
+		EnterCriticalSection(&m_cs);
+		bool cancelled = false;
+		if (index < m_nodes.size() && m_nodes[index].generation == generation) {
+			TimerNode* node = &m_nodes[index];
+			if (node->state == kArmed) {
+				Unlink(node);
+				FreeNode(node);
+				cancelled = true;
+			}
+			else if (node->state == kFiring) {
+				// 만료 목록에 모였지만 아직 시작하지 않은 콜백은 건너뛰게 하고,
+				// 실행 중인 주기 타이머는 끝난 뒤 다시 등록하지 않게 함
+				bool running = (m_running == node);
+				if (!running || node->period > 0) {
+					node->state = kCancelled;
+					cancelled = true;
+				}
+				if (running && GetCurrentThreadId() != m_serviceThreadId) {
+					while (m_running == node) SleepConditionVariableCS(&m_callbackDone, &m_cs, INFINITE);
+				}
 			}
+		}
+		LeaveCriticalSection(&m_cs);
+		return cancelled;
+	}
+
+	size_t GetArmedCount()
+	{
+		EnterCriticalSection(&m_cs);
+		size_t count = m_armedCount;
+		LeaveCriticalSection(&m_cs);
+		return count;
+	}
+
+	// 휠이 사용하는 시계 (1틱 = 1ms)
+	ULONGLONG NowTick() const
+	{
+		LARGE_INTEGER now;
+		QueryPerformanceCounter(&now);
+		return (ULONGLONG)((now.QuadPart - m_startTime.QuadPart) * 1000 / m_frequency.QuadPart);
+	}
 
-			CloseHandle(hThread);
-			return;
+private:
+	TimerId AddTimer(DWORD delayMs, DWORD period, Callback callback)
+	{
+		ULONGLONG now = NowTick();
 
-		case WAIT_TIMEOUT:
-			std::cout << "아직 실행 중... 계속 대기" << std::endl;
-			break;
+		EnterCriticalSection(&m_cs);
+		TimerNode* node = AllocateNode();
+		node->callback = std::move(callback);
+		node->period = period;
+		node->expireTick = now + delayMs + 1;   // 현재 틱은 이미 일부 지났으므로 올림해서 일찍 발생하지 않게 함
+		node->state = kArmed;
+		Link(node);
 
-		case WAIT_FAILED:
-			std::cout << "대기 중 오류 발생! 오류 코드: " << GetLastError() << std::endl;
-			CloseHandle(hThread);
-			return;
+		// 서비스 스레드가 이 타이머보다 늦게 깨어날 예정이면 미리 깨움
+		bool wake = node->expireTick < m_plannedWakeTick;
+		if (wake) m_plannedWakeTick = node->expireTick;
+		TimerId id = ((TimerId)node->generation << 32) | node->index;
+		LeaveCriticalSection(&m_cs);
+
+		if (wake && m_hWakeEvent) SetEvent(m_hWakeEvent);
+		return id;
+	}
+
+	TimerNode* AllocateNode()
+	{
+		if (!m_freeNodes.empty()) {
+			TimerNode* node = &m_nodes[m_freeNodes.back()];
+			m_freeNodes.pop_back();
+			return node;
 		}
+
+		m_nodes.push_back(TimerNode());
+		TimerNode* node = &m_nodes.back();
+		node->index = (DWORD)(m_nodes.size() - 1);
+		node->generation = 1;
+		return node;
 	}
-}
 
-void DemonstrateMultipleObjectsWait()
-{
-	std::cout << "\n=== WaitForMultipleObjects 데모 (_beginthreadex 사용) ===" << std::endl;
+	void FreeNode(TimerNode* node)
+	{
+		node->callback = nullptr;   // 캡처한 자원을 바로 해제
+		node->state = kFree;
+		++node->generation;
+		if (node->generation == 0) node->generation = 1;   // id 0이 나오지 않도록
+		m_freeNodes.push_back(node->index);
+	}
 
-	// 다양한 유형의 스레드 생성
-	int ids[] = { 1, 2, 3 };
-	HANDLE threads[3];
-	unsigned threadIds[3];
+	// 남은 시간에 맞는 레벨과 칸에 넣는다
+	void Link(TimerNode* node)
+	{
+		if (node->expireTick < m_currentTick) node->expireTick = m_currentTick;
+		ULONGLONG delta = node->expireTick - m_currentTick;
 
-	threads[0] = reinterpret_cast<HANDLE>(_beginthreadex(NULL, 0, FastWorker, &ids[0], 0, &threadIds[0]));
-	threads[1] = reinterpret_cast<HANDLE>(_beginthreadex(NULL, 0, SlowWorker, &ids[1], 0, &threadIds[1]));
-	threads[2] = reinterpret_cast<HANDLE>(_beginthreadex(NULL, 0, UnpredictableWorker, &ids[2], 0, &threadIds[2]));
+		// delta가 kMaxDelay를 넘어도 레벨 3의 만료 시각 칸에 둠. 그 칸은 2^26틱마다
+		// cascade되고, 그때마다 다시 Link되어 남은 시간이 범위 안이 되면 아래로 내려감
+		int level = 0;
+		DWORD slot = (DWORD)(node->expireTick & (kLevel0Size - 1));
+		for (int l = 1; l < kLevelCount; ++l) {
+			int shift = kLevel0Bits + kLevelBits * (l - 1);
+			if (delta < (1ull << shift)) break;
+			level = l;
+			slot = (DWORD)((node->expireTick >> shift) & (kLevelSize - 1));
+		}
+
+		node->level = level;
+		node->slot = slot;
+		node->prev = nullptr;
+		node->next = m_slots[level][slot];
+		if (node->next) node->next->prev = node;
+		m_slots[level][slot] = node;
+		m_occupied[level][slot / 64] |= 1ull << (slot % 64);
+		++m_armedCount;
+	}
 
-	// 핸들 유효성 검사
-	bool allValid = true;
-	for (int i = 0; i < 3; i++)
+	void Unlink(TimerNode* node)
 	{
-		if (threads[i] == NULL)
-		{
-			std::cout << "스레드 " << i + 1 << " 생성 실패! 오류 코드: " << GetLastError() << std::endl;
-			allValid = false;
+		if (node->prev) node->prev->next = node->next;
+		else m_slots[node->level][node->slot] = node->next;
+		if (node->next) node->next->prev = node->prev;
+		if (m_slots[node->level][node->slot] == nullptr) {
+			m_occupied[node->level][node->slot / 64] &= ~(1ull << (node->slot % 64));
+		}
+		node->prev = node->next = nullptr;
+		--m_armedCount;
+	}
 
-			// 이미 생성된 스레드들 정리
-			for (int j = 0; j < i; j++)
-			{
-				CloseHandle(threads[j]);
+	// 상위 레벨 칸의 타이머를 남은 시간에 맞게 다시 배치. 칸 번호를 반환
+	DWORD Cascade(int level)
+	{
+		int shift = kLevel0Bits + kLevelBits * (level - 1);
+		DWORD slot = (DWORD)((m_currentTick >> shift) & (kLevelSize - 1));
+
+		TimerNode* node = m_slots[level][slot];
+		m_slots[level][slot] = nullptr;
+		m_occupied[level][slot / 64] &= ~(1ull << (slot % 64));
+		while (node) {
+			TimerNode* next = node->next;
+			--m_armedCount;
+			Link(node);
+			node = next;
+		}
+		return slot;
+	}
+
+	// nowTick까지 틱을 진행하며 만료된 노드를 expired에 모은다
+	void Advance(ULONGLONG nowTick, std::vector<TimerNode*>& expired)
+	{
+		while (m_currentTick <= nowTick) {
+			DWORD slot = (DWORD)(m_currentTick & (kLevel0Size - 1));
+			if (slot == 0) {
+				for (int level = 1; level < kLevelCount; ++level) {
+					if (Cascade(level) != 0) break;
+				}
+			}
+
+			TimerNode* node = m_slots[0][slot];
+			while (node) {
+				TimerNode* next = node->next;
+				Unlink(node);
+				node->state = kFiring;
+				expired.push_back(node);
+				node = next;
 			}
+			++m_currentTick;
 		}
 	}
 
-	if (!allValid) return;
+	// 다음에 깨어나야 할 틱. 레벨 0에 타이머가 없으면 다음 cascade 시점
+	ULONGLONG NextWakeTick() const
+	{
+		if (m_armedCount == 0) return ULLONG_MAX;
 
-	std::cout << "\n--- 시나리오 1: 첫 번째 완료되는 스레드 대기 ---" << std::endl;
-	DWORD firstCompleted = WaitForMultipleObjects(3, threads, FALSE, INFINITE);
+		DWORD start = (DWORD)(m_currentTick & (kLevel0Size - 1));
+		for (DWORD slot = start; slot < kLevel0Size; ++slot) {
+			ULONGLONG word = m_occupied[0][slot / 64] >> (slot % 64);
+			if (word == 0) {
+				slot = (slot / 64 + 1) * 64 - 1;   // 이 64비트 묶음은 비었으니 건너뜀
+				continue;
+			}
+			if (word & 1) return m_currentTick + (slot - start);
+		}
+		// 다음에 slot 0이 되는 틱 (start가 0이면 지금 바로 cascade해야 함)
+		return m_currentTick + ((kLevel0Size - start) & (kLevel0Size - 1));
+	}
 
-	//만약 첫 번째 스레드(threads[0])가 종료되었다면, WAIT_OBJECT_0 값을 리턴합니다.
-	//만약 두 번째 스레드(threads[1])가 종료되었다면, WAIT_OBJECT_0 + 1 값을 리턴합니다.  
-	//만약 세 번째 스레드(threads[2])가 종료되었다면, WAIT_OBJECT_0 + 2 값을 리턴합니다.
-	if (firstCompleted >= WAIT_OBJECT_0 && firstCompleted < WAIT_OBJECT_0 + 3)
+	static unsigned __stdcall ServiceThreadProc(void* param)
 	{
-		int completedIndex = firstCompleted - WAIT_OBJECT_0;
-		std::cout << "첫 번째 완료: 스레드 " << completedIndex + 1 << std::endl;
+		static_cast<TimerWheel*>(param)->ServiceLoop();
+		return 0;
+	}
 
-		// 완료된 스레드의 종료 코드 확인
-		DWORD exitCode;
-		if (GetExitCodeThread(threads[completedIndex], &exitCode))
-		{
-			std::cout << "완료된 스레드의 종료 코드: " << exitCode << std::endl;
+	void ServiceLoop()
+	{
+		std::vector<TimerNode*> expired;
+
+		EnterCriticalSection(&m_cs);
+		m_serviceThreadId = GetCurrentThreadId();
+		LeaveCriticalSection(&m_cs);
+
+		while (!m_bStop) {
+			EnterCriticalSection(&m_cs);
+			Advance(NowTick(), expired);
+			LeaveCriticalSection(&m_cs);
+
+			// 콜백은 잠금 밖에서 실행 (콜백 안에서 Add/Cancel 가능)
+			for (TimerNode* node : expired) {
+				EnterCriticalSection(&m_cs);
+				if (node->state == kCancelled) {   // 모인 뒤 실행 전에 취소됨
+					FreeNode(node);
+					LeaveCriticalSection(&m_cs);
+					continue;
+				}
+				m_running = node;
+				LeaveCriticalSection(&m_cs);
+
+				node->callback();
+
+				EnterCriticalSection(&m_cs);
+				m_running = nullptr;
+				if (node->state == kFiring && node->period > 0) {
+					node->state = kArmed;
+					node->expireTick += node->period;   // 누적 오차가 생기지 않도록 예정 시각 기준
+					Link(node);
+				}
+				else {
+					FreeNode(node);
+				}
+				LeaveCriticalSection(&m_cs);
+				WakeAllConditionVariable(&m_callbackDone);
+			}
+			expired.clear();
+
+			EnterCriticalSection(&m_cs);
+			ULONGLONG wakeTick = NextWakeTick();
+			m_plannedWakeTick = wakeTick;
+			LeaveCriticalSection(&m_cs);
+
+			DWORD timeout = INFINITE;
+			if (wakeTick != ULLONG_MAX) {
+				ULONGLONG now = NowTick();
+				timeout = wakeTick > now ? (DWORD)(wakeTick - now) : 0;
+			}
+			if (timeout > 0) WaitForSingleObject(m_hWakeEvent, timeout);
 		}
 	}
+};
+
+// ============================================================================
+// Future / Promise
+// ============================================================================
+// 스레드 종료 코드로 결과를 받으면 결과 하나마다 OS 스레드가 하나 필요하고 값도 DWORD뿐입니다.
+// RunAsync는 작업을 Windows 스레드 풀에서 실행하고 결과를 Future<T>로 돌려줍니다.
+// 각 Future의 상태는 원자적 워드 하나(m_state)로 관리합니다.
+//   nullptr    : 완료 전, 등록된 후속 작업 없음
+//   ReadyMark  : 값이 준비됨
+//   그 외       : 완료 전, 후속 작업 스택(ContinuationNode)의 머리
+// 등록은 CAS, 완료는 교환 한 번이라 잠금이 없고, Get()은 WaitOnAddress로 기다립니다.
 
-	std::cout << "\n--- 시나리오 2: 모든 스레드 완료 대기 ---" << std::endl;
-	DWORD allCompleted = WaitForMultipleObjects(3, threads, TRUE, INFINITE);
+template <typename T> class Future;
+template <typename T> class Promise;
 
-	if (allCompleted == WAIT_OBJECT_0)
+struct ContinuationNode
+{
+	std::function<void()> fn;
+	ContinuationNode* next;
+};
+
+template <typename T>
+class FutureState
+{
+private:
+	std::atomic<ContinuationNode*> m_state;
+	T m_value;
+
+	static ContinuationNode* ReadyMark() { return reinterpret_cast<ContinuationNode*>(1); }
+
+public:
+	FutureState() : m_state(nullptr), m_value() {}
+
+	~FutureState()
 	{
-		std::cout << "모든 스레드 완료!" << std::endl;
+		// 완료되지 못한 채 버려진 경우 남은 후속 작업 정리
+		ContinuationNode* node = m_state.load(std::memory_order_acquire);
+		if (node == ReadyMark()) return;
+		while (node) {
+			ContinuationNode* next = node->next;
+			delete node;
+			node = next;
+		}
+	}
 
-		// 각 스레드의 종료 코드 확인
-		for (int i = 0; i < 3; i++)
-		{
-			DWORD exitCode;
-			if (GetExitCodeThread(threads[i], &exitCode))
-			{
-				std::cout << "스레드 " << i + 1 << " 종료 코드: " << exitCode << std::endl;
+	bool IsReady() const { return m_state.load(std::memory_order_acquire) == ReadyMark(); }
+
+	// 한 Future에 한 번만 호출해야 함
+	void SetValue(T value)
+	{
+		m_value = std::move(value);
+		ContinuationNode* list = m_state.exchange(ReadyMark(), std::memory_order_acq_rel);
+		WakeByAddressAll(&m_state);
+
+		// 스택이므로 뒤집어서 등록한 순서대로 실행
+		ContinuationNode* ordered = nullptr;
+		while (list) {
+			ContinuationNode* next = list->next;
+			list->next = ordered;
+			ordered = list;
+			list = next;
+		}
+		while (ordered) {
+			ContinuationNode* next = ordered->next;
+			ordered->fn();
+			delete ordered;
+			ordered = next;
+		}
+	}
+
+	// 완료되면 fn 실행 (완료한 스레드에서). 이미 완료됐으면 호출한 스레드에서 바로 실행
+	void OnReady(std::function<void()> fn)
+	{
+		ContinuationNode* head = m_state.load(std::memory_order_acquire);
+		if (head != ReadyMark()) {
+			ContinuationNode* node = new ContinuationNode{ std::move(fn), nullptr };
+			while (head != ReadyMark()) {
+				node->next = head;
+				if (m_state.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_acquire)) return;
+			}
+			fn = std::move(node->fn);
+			delete node;
+		}
+		fn();
+	}
+
+	// 완료까지 최대 milliseconds 대기. 완료되었으면 true
+	bool WaitFor(DWORD milliseconds)
+	{
+		ULONGLONG deadline = GetTickCount64() + milliseconds;
+		ContinuationNode* observed = m_state.load(std::memory_order_acquire);
+		while (observed != ReadyMark()) {
+			DWORD timeout = INFINITE;
+			if (milliseconds != INFINITE) {
+				ULONGLONG now = GetTickCount64();
+				if (now >= deadline) return false;
+				timeout = (DWORD)(deadline - now);
 			}
+			WaitOnAddress(&m_state, &observed, sizeof(observed), timeout);
+			observed = m_state.load(std::memory_order_acquire);
 		}
+		return true;
+	}
+
+	const T& Get()
+	{
+		WaitFor(INFINITE);
+		return m_value;
+	}
+};
+
+template <typename T>
+class Future
+{
+private:
+	std::shared_ptr<FutureState<T>> m_state;
+
+public:
+	Future() {}
+	explicit Future(std::shared_ptr<FutureState<T>> state) : m_state(std::move(state)) {}
+
+	bool IsValid() const { return m_state != nullptr; }
+	bool IsReady() const { return m_state->IsReady(); }
+	bool WaitFor(DWORD milliseconds) const { return m_state->WaitFor(milliseconds); }
+	const T& Get() const { return m_state->Get(); }
+
+	void OnReady(std::function<void()> fn) const { m_state->OnReady(std::move(fn)); }
+
+	// 후속 작업: 이 Future의 값으로 fn을 실행한 결과를 새 Future로 돌려줌
+	template <typename F>
+	auto Then(F fn) const -> Future<decltype(fn(std::declval<const T&>()))>
+	{
+		typedef decltype(fn(std::declval<const T&>())) R;
+		Promise<R> promise;
+		Future<R> next = promise.GetFuture();
+		std::shared_ptr<FutureState<T>> state = m_state;
+		m_state->OnReady([state, promise, fn]() mutable {
+			promise.SetValue(fn(state->Get()));
+		});
+		return next;
+	}
+};
+
+template <typename T>
+class Promise
+{
+private:
+	std::shared_ptr<FutureState<T>> m_state;
+
+public:
+	Promise() : m_state(std::make_shared<FutureState<T>>()) {}
+
+	Future<T> GetFuture() const { return Future<T>(m_state); }
+	void SetValue(T value) const { m_state->SetValue(std::move(value)); }
+};
+
+VOID CALLBACK RunPoolJob(PTP_CALLBACK_INSTANCE, PVOID context)
+{
+	std::unique_ptr<std::function<void()>> job(static_cast<std::function<void()>*>(context));
+	(*job)();
+}
+
+void SubmitToPool(std::function<void()> fn)
+{
+	std::function<void()>* job = new std::function<void()>(std::move(fn));
+	if (!TrySubmitThreadpoolCallback(RunPoolJob, job, NULL)) {
+		// 풀에 넣지 못하면 호출한 스레드에서 실행
+		(*job)();
+		delete job;
 	}
-	else if (allCompleted == WAIT_FAILED)
+}
+
+// fn을 스레드 풀에서 실행하고 반환값을 Future로 받음
+template <typename F>
+auto RunAsync(F fn) -> Future<decltype(fn())>
+{
+	typedef decltype(fn()) R;
+	Promise<R> promise;
+	Future<R> future = promise.GetFuture();
+
+	SubmitToPool([promise, fn]() mutable {
+		promise.SetValue(fn());
+	});
+	return future;
+}
+
+// 모든 Future가 완료되면 결과를 입력 순서대로 모은 vector로 완료
+template <typename T>
+Future<std::vector<T>> WhenAll(const std::vector<Future<T>>& futures)
+{
+	// 후속 작업들이 서로 다른 풀 스레드에서 동시에 결과를 쓰므로 원소마다 별도 객체인
+	// 배열에 모음 (vector<bool>은 이웃 원소가 같은 워드를 공유해 데이터 경합이 됨)
+	struct AllState
 	{
-		std::cout << "모든 스레드 대기 중 오류 발생! 오류 코드: " << GetLastError() << std::endl;
+		std::unique_ptr<T[]> results;
+		size_t count;
+		std::atomic<size_t> remaining;
+		Promise<std::vector<T>> promise;
+	};
+
+	std::shared_ptr<AllState> all = std::make_shared<AllState>();
+	all->results.reset(new T[futures.size()]());
+	all->count = futures.size();
+	all->remaining.store(futures.size());
+	Future<std::vector<T>> result = all->promise.GetFuture();
+
+	if (futures.empty()) {
+		all->promise.SetValue(std::vector<T>());
+		return result;
 	}
 
-	// 핸들 정리
-	for (int i = 0; i < 3; i++)
+	for (size_t i = 0; i < futures.size(); ++i) {
+		Future<T> future = futures[i];
+		future.OnReady([all, future, i]() {
+			all->results[i] = future.Get();
+			if (all->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+				std::vector<T> values;
+				values.reserve(all->count);
+				for (size_t k = 0; k < all->count; ++k) values.push_back(std::move(all->results[k]));
+				all->promise.SetValue(std::move(values));
+			}
+		});
+	}
+	return result;
+}
+
+// 가장 먼저 완료된 Future의 (번호, 값)으로 완료
+template <typename T>
+Future<std::pair<size_t, T>> WhenAny(const std::vector<Future<T>>& futures)
+{
+	struct AnyState
 	{
-		CloseHandle(threads[i]);
+		std::atomic<bool> done;
+		Promise<std::pair<size_t, T>> promise;
+	};
+
+	std::shared_ptr<AnyState> any = std::make_shared<AnyState>();
+	any->done.store(false);
+	Future<std::pair<size_t, T>> result = any->promise.GetFuture();
+
+	for (size_t i = 0; i < futures.size(); ++i) {
+		Future<T> future = futures[i];
+		future.OnReady([any, future, i]() {
+			if (!any->done.exchange(true, std::memory_order_acq_rel)) {
+				any->promise.SetValue(std::make_pair(i, future.Get()));
+			}
+		});
 	}
+	return result;
+}
+
+// ============================================================================
+// 경주 실행 (first-completed-wins / hedged request)
+// ============================================================================
+// 같은 요청을 여러 번 보내고 가장 먼저 끝난 결과를 쓰는 패턴에서, 진 작업들이
+// 끝까지 실행되면 그만큼 CPU와 스레드를 낭비합니다. Race는 첫 결과가 나오면
+// StopSource로 중지를 요청하고, 진 작업들이 실제로 쓴 시간을 낭비량으로 보고합니다.
+
+// StopSource / StopToken은 ../Common/StopToken.h에 있음 (04__beginthread와 공유)
+
+// 작업이 하나도 없어 승자가 없을 때의 winner 값
+const size_t kNoRaceWinner = (size_t)-1;
+
+// 경주가 모두 정리된 뒤의 결과 보고
+struct RaceReport
+{
+	size_t winner;          // 이긴 작업 번호 (작업이 없었으면 kNoRaceWinner)
+	double winnerMs;        // 이긴 작업의 실행 시간
+	double wastedMs;        // 진 작업들이 실행된 시간의 합 (낭비)
+	int losersStarted;      // 시작은 했지만 진 작업 수
+	int losersSkipped;      // 헤지 지연 중에 승부가 나서 시작도 안 한 작업 수
+};
+
+template <typename T>
+struct RaceHandle
+{
+	Future<std::pair<size_t, T>> first;   // 가장 먼저 끝난 작업의 (번호, 값). 작업이 없으면 무효 (IsValid() == false)
+	Future<RaceReport> report;            // 진 작업까지 모두 반환한 뒤 완료
+};
+
+// tasks를 모두 풀에서 실행하고 먼저 끝난 결과를 채택. 작업은 StopToken을 확인해서 일찍 반환해야 함
+// hedgeDelayMs > 0이면 i번째 작업은 i * hedgeDelayMs 뒤에 시작 (그 전에 승부가 나면 시작하지 않음)
+template <typename T>
+RaceHandle<T> Race(const std::vector<std::function<T(const StopToken&)>>& tasks, DWORD hedgeDelayMs = 0)
+{
+	struct RaceState
+	{
+		StopSource stop;
+		std::atomic<bool> decided;
+		std::atomic<int> remaining;
+		std::atomic<LONGLONG> wastedTicks;
+		std::atomic<int> losersStarted;
+		std::atomic<int> losersSkipped;
+		size_t winner;
+		LONGLONG winnerTicks;
+		LONGLONG frequency;
+		Promise<std::pair<size_t, T>> first;
+		Promise<RaceReport> report;
+	};
+
+	std::shared_ptr<RaceState> race = std::make_shared<RaceState>();
+	race->decided.store(false);
+	race->remaining.store((int)tasks.size());
+	race->wastedTicks.store(0);
+	race->losersStarted.store(0);
+	race->losersSkipped.store(0);
+	race->winner = 0;
+	race->winnerTicks = 0;
+	LARGE_INTEGER freq;
+	QueryPerformanceFrequency(&freq);
+	race->frequency = freq.QuadPart;
+
+	// 작업이 없으면 아무것도 완료하지 않으므로 Get()이 영원히 막힘
+	// 결과를 줄 수 없는 first는 무효로 두고, 보고서는 바로 완료
+	if (tasks.empty()) {
+		RaceReport empty = { kNoRaceWinner, 0.0, 0.0, 0, 0 };
+		race->report.SetValue(empty);
+		RaceHandle<T> handle = { Future<std::pair<size_t, T>>(), race->report.GetFuture() };
+		return handle;
+	}
+
+	RaceHandle<T> handle = { race->first.GetFuture(), race->report.GetFuture() };
+
+	// 마지막으로 반환한 작업이 보고서를 완성
+	auto finishOne = [](const std::shared_ptr<RaceState>& r) {
+		if (r->remaining.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+		RaceReport report;
+		report.winner = r->winner;
+		report.winnerMs = (double)r->winnerTicks * 1000.0 / r->frequency;
+		report.wastedMs = (double)r->wastedTicks.load() * 1000.0 / r->frequency;
+		report.losersStarted = r->losersStarted.load();
+		report.losersSkipped = r->losersSkipped.load();
+		r->report.SetValue(report);
+	};
+
+	for (size_t i = 0; i < tasks.size(); ++i) {
+		std::function<T(const StopToken&)> task = tasks[i];
+		DWORD delay = hedgeDelayMs * (DWORD)i;
+
+		SubmitToPool([race, task, i, delay, finishOne]() {
+			StopToken token = race->stop.GetToken();
+			if (delay > 0 && !token.SleepFor(delay)) {
+				race->losersSkipped.fetch_add(1);
+				finishOne(race);
+				return;
+			}
+
+			LARGE_INTEGER start, end;
+			QueryPerformanceCounter(&start);
+			T value = task(token);
+			QueryPerformanceCounter(&end);
+
+			if (!race->decided.exchange(true, std::memory_order_acq_rel)) {
+				race->winner = i;
+				race->winnerTicks = end.QuadPart - start.QuadPart;
+				race->stop.RequestStop();   // 나머지 작업에 중지 요청
+				race->first.SetValue(std::make_pair(i, std::move(value)));
+			}
+			else {
+				race->wastedTicks.fetch_add(end.QuadPart - start.QuadPart);
+				race->losersStarted.fetch_add(1);
+			}
+			finishOne(race);
+		});
+	}
+	return handle;
+}
+
+// 중지 요청을 확인하는 UnpredictableWorker: 1~5초 중 무작위로 걸리고, 지면 바로 반환
+unsigned CancellableUnpredictableWorker(int id, const StopToken& token)
+{
+	std::random_device rd;
+	std::mt19937 gen(rd());
+	std::uniform_int_distribution<> dis(1, 5);
+	int sleepTime = dis(gen) * 1000;
+
+	std::cout << "[경주작업 " << id << "] 시작, 예상 시간: " << sleepTime / 1000 << "초" << std::endl;
+	if (!token.SleepFor(sleepTime)) {
+		std::cout << "[경주작업 " << id << "] 중지 요청으로 조기 종료" << std::endl;
+		return 0;
+	}
+	std::cout << "[경주작업 " << id << "] 완료" << std::endl;
+	return 400 + id;
+}
+
+void DemonstrateSingleObjectWait(TimerWheel& wheel)
+{
+	std::cout << "=== WaitForSingleObject 데모 (_beginthreadex 사용) ===" << std::endl;
+
+	int workerId = 1;
+	unsigned threadId;
+
+	// _beginthreadex로 스레드 생성하고 핸들 얻기
+	HANDLE hThread = reinterpret_cast<HANDLE>(_beginthreadex(
+		NULL,           // 보안 속성
+		0,              // 스택 크기 (기본값)
+		SlowWorker,     // 스레드 함수
+		&workerId,      // 매개변수
+		0,              // 생성 플래그
+		&threadId       // 스레드 ID
+	));
+
+	if (hThread == NULL)
+	{
+		std::cout << "스레드 생성 실패! 오류 코드: " << GetLastError() << std::endl;
+		return;
+	}
+
+	std::cout << "스레드 작업 중... 2초마다 상태 확인" << std::endl;
+
+	// 2초마다 상태 출력은 공용 타이머 휠 스레드가 맡고, 여기서는 완료만 기다림
+	TimerId statusTimer = wheel.AddPeriodic(2000, []() {
+		std::cout << "아직 실행 중... 계속 대기" << std::endl;
+	});
+
+	DWORD waitResult = WaitForSingleObject(hThread, INFINITE);
+	wheel.Cancel(statusTimer);
+
+	switch (waitResult)
+	{
+	case WAIT_OBJECT_0:
+		std::cout << "스레드 완료!" << std::endl;
+
+		DWORD exitCode;
+		if (GetExitCodeThread(hThread, &exitCode))
+		{
+			std::cout << "종료 코드: " << exitCode << std::endl;
+		}
+		break;
+
+	case WAIT_FAILED:
+		std::cout << "대기 중 오류 발생! 오류 코드: " << GetLastError() << std::endl;
+		break;
+	}
+
+	CloseHandle(hThread);
+}
+
+void DemonstrateMultipleObjectsWait()
+{
+	std::cout << "\n=== WhenAny / WhenAll 데모 (스레드 풀 + Future 사용) ===" << std::endl;
+
+	// 작업마다 스레드를 만들지 않고 풀에서 실행, 결과는 종료 코드 대신 Future로 받음
+	std::vector<Future<unsigned>> futures;
+	futures.push_back(RunAsync([]() { int id = 1; return FastWorker(&id); }));
+	futures.push_back(RunAsync([]() { int id = 2; return SlowWorker(&id); }));
+	futures.push_back(RunAsync([]() { int id = 3; return UnpredictableWorker(&id); }));
+
+	std::cout << "\n--- 시나리오 1: 첫 번째 완료되는 작업 대기 ---" << std::endl;
+	std::pair<size_t, unsigned> first = WhenAny(futures).Get();
+	std::cout << "첫 번째 완료: 작업 " << first.first + 1 << std::endl;
+	std::cout << "완료된 작업의 결과: " << first.second << std::endl;
+
+	std::cout << "\n--- 시나리오 2: 모든 작업 완료 대기 ---" << std::endl;
+	// 후속 작업(Then)으로 DWORD가 아닌 결과(문자열)도 바로 만들 수 있음
+	Future<std::string> summary = WhenAll(futures).Then([](const std::vector<unsigned>& results) {
+		std::string text;
+		for (size_t i = 0; i < results.size(); i++)
+		{
+			text += "작업 " + std::to_string(i + 1) + " 결과: " + std::to_string(results[i]) + "\n";
+		}
+		return text;
+	});
+
+	const std::string& text = summary.Get();
+	std::cout << "모든 작업 완료!" << std::endl;
+	std::cout << text;
+}
+
+void DemonstrateRace()
+{
+	std::cout << "\n=== Race 데모: 먼저 끝난 결과만 쓰고 나머지는 중지 ===" << std::endl;
+
+	std::vector<std::function<unsigned(const StopToken&)>> tasks;
+	for (int id = 1; id <= 3; id++)
+	{
+		tasks.push_back([id](const StopToken& token) { return CancellableUnpredictableWorker(id, token); });
+	}
+
+	RaceHandle<unsigned> race = Race(tasks);
+	std::pair<size_t, unsigned> first = race.first.Get();
+	std::cout << "첫 번째 완료: 작업 " << first.first + 1 << ", 결과: " << first.second << std::endl;
+
+	// 진 작업들이 중지 요청을 받고 반환할 때까지 기다린 뒤 낭비량 확인
+	const RaceReport& report = race.report.Get();
+	std::cout << "진 작업 " << report.losersStarted << "개가 낭비한 시간: " << report.wastedMs << "ms" << std::endl;
 }
 
 void DemonstrateTimeoutWait()
@@ -236,7 +986,7 @@ void DemonstrateTimeoutWait()
 }
 
 // 추가 데모: 주기적 상태 확인
-void DemonstratePeriodicStatusCheck()
+void DemonstratePeriodicStatusCheck(TimerWheel& wheel)
 {
 	std::cout << "\n=== 주기적 상태 확인 데모 ===" << std::endl;
 
@@ -253,51 +1003,364 @@ void DemonstratePeriodicStatusCheck()
 		return;
 	}
 
-	int checkCount = 0;
-	while (true)
+	// 1초마다 진행 상황 표시 (타이머 휠 스레드에서 실행)
+	// 카운터는 콜백과 소유권을 나눠 가져 이 함수의 스택 수명에 묶이지 않게 함
+	std::shared_ptr<volatile LONG> checkCount = std::make_shared<volatile LONG>(0);
+	TimerId progressTimer = wheel.AddPeriodic(1000, [checkCount]() {
+		LONG count = InterlockedIncrement(checkCount.get());
+		std::cout << "." << std::flush;  // 진행 상황 표시
+		if (count % 10 == 0)
+		{
+			std::cout << " (" << count << "초 경과)" << std::endl;
+		}
+	});
+
+	DWORD waitResult = WaitForSingleObject(hThread, INFINITE);
+	wheel.Cancel(progressTimer);
+
+	switch (waitResult)
 	{
-		DWORD waitResult = WaitForSingleObject(hThread, 1000);  // 1초마다 확인
+	case WAIT_OBJECT_0:
+		std::cout << "\n작업 완료! 총 " << *checkCount << "번 확인함" << std::endl;
 
-		switch (waitResult)
+		DWORD exitCode;
+		if (GetExitCodeThread(hThread, &exitCode))
 		{
-		case WAIT_OBJECT_0:
-			std::cout << "\n작업 완료! 총 " << checkCount << "번 확인함" << std::endl;
+			std::cout << "종료 코드: " << exitCode << std::endl;
+		}
+		break;
 
-			DWORD exitCode;
-			if (GetExitCodeThread(hThread, &exitCode))
-			{
-				std::cout << "종료 코드: " << exitCode << std::endl;
-			}
+	case WAIT_FAILED:
+		std::cout << "\n상태 확인 실패!" << std::endl;
+		break;
+	}
 
-			CloseHandle(hThread);
-			return;
+	CloseHandle(hThread);
+}
 
-		case WAIT_TIMEOUT:
-			checkCount++;
-			std::cout << "." << std::flush;  // 진행 상황 표시
-			if (checkCount % 10 == 0)
-			{
-				std::cout << " (" << checkCount << "초 경과)" << std::endl;
+// ============================================================================
+// 타임아웃 벤치마크: 타이머 휠 vs 대기마다 스레드 하나
+// ============================================================================
+ULONGLONG GetProcessCpuTime100ns()
+{
+	FILETIME creation, exitTime, kernel, user;
+	GetProcessTimes(GetCurrentProcess(), &creation, &exitTime, &kernel, &user);
+	ULONGLONG k = ((ULONGLONG)kernel.dwHighDateTime << 32) | kernel.dwLowDateTime;
+	ULONGLONG u = ((ULONGLONG)user.dwHighDateTime << 32) | user.dwLowDateTime;
+	return k + u;
+}
+
+struct TimeoutBenchData
+{
+	std::vector<LONGLONG> deadlines;   // 발생해야 하는 시각 (QPC)
+	std::vector<LONGLONG> fired;       // 실제 발생한 시각 (QPC)
+	volatile LONG remaining;
+	HANDLE hDone;
+};
+
+void PrintTimeoutBenchResult(const char* label, TimeoutBenchData& data, ULONGLONG cpu100ns, LONGLONG frequency)
+{
+	std::vector<double> lateMs(data.fired.size());
+	for (size_t i = 0; i < lateMs.size(); ++i) {
+		lateMs[i] = (double)(data.fired[i] - data.deadlines[i]) * 1000.0 / frequency;
+	}
+	std::sort(lateMs.begin(), lateMs.end());
+
+	double sum = 0;
+	for (double v : lateMs) sum += v;
+
+	char line[256];
+	StringCchPrintfA(line, 256, "%-16s %7zu개 | 지연 평균 %6.2f ms, p99 %6.2f ms, 최대 %6.2f ms | CPU %8.1f ms (대기당 %6.2f us)",
+		label, lateMs.size(), sum / lateMs.size(), lateMs[lateMs.size() * 99 / 100], lateMs.back(),
+		cpu100ns / 10000.0, cpu100ns / 10.0 / lateMs.size());
+	std::cout << line << std::endl;
+}
+
+void PrepareTimeoutBench(TimeoutBenchData& data, std::vector<DWORD>& delays, size_t count)
+{
+	std::mt19937 gen(12345);
+	std::uniform_int_distribution<DWORD> dis(100, 2000);
+	delays.resize(count);
+	for (auto& d : delays) d = dis(gen);
+
+	data.deadlines.assign(count, 0);
+	data.fired.assign(count, 0);
+	data.remaining = (LONG)count;
+	data.hDone = CreateEvent(NULL, TRUE, FALSE, NULL);
+}
+
+void RunWheelTimeoutBench(size_t count, LONGLONG frequency)
+{
+	TimeoutBenchData data;
+	std::vector<DWORD> delays;
+	PrepareTimeoutBench(data, delays, count);
+
+	TimerWheel wheel;
+	wheel.Start();
+
+	ULONGLONG cpuBefore = GetProcessCpuTime100ns();
+	for (size_t i = 0; i < count; ++i) {
+		LARGE_INTEGER now;
+		QueryPerformanceCounter(&now);
+		data.deadlines[i] = now.QuadPart + (LONGLONG)delays[i] * frequency / 1000;
+
+		TimeoutBenchData* pData = &data;
+		wheel.AddTimeout(delays[i], [pData, i]() {
+			LARGE_INTEGER firedAt;
+			QueryPerformanceCounter(&firedAt);
+			pData->fired[i] = firedAt.QuadPart;
+			if (InterlockedDecrement(&pData->remaining) == 0) SetEvent(pData->hDone);
+		});
+	}
+	WaitForSingleObject(data.hDone, INFINITE);
+	ULONGLONG cpuUsed = GetProcessCpuTime100ns() - cpuBefore;
+
+	wheel.Stop();
+	CloseHandle(data.hDone);
+	PrintTimeoutBenchResult("타이머 휠", data, cpuUsed, frequency);
+}
+
+struct PollingWaitParams
+{
+	TimeoutBenchData* data;
+	size_t index;
+	DWORD delay;
+	HANDLE hNeverSignaled;
+};
+
+unsigned __stdcall PollingWaitThread(void* param)
+{
+	PollingWaitParams* p = static_cast<PollingWaitParams*>(param);
+	WaitForSingleObject(p->hNeverSignaled, p->delay);   // 기존 방식: 대기마다 스레드가 타임아웃까지 대기
+
+	LARGE_INTEGER firedAt;
+	QueryPerformanceCounter(&firedAt);
+	p->data->fired[p->index] = firedAt.QuadPart;
+	if (InterlockedDecrement(&p->data->remaining) == 0) SetEvent(p->data->hDone);
+	return 0;
+}
+
+void RunThreadPerWaitBench(size_t count, LONGLONG frequency)
+{
+	TimeoutBenchData data;
+	std::vector<DWORD> delays;
+	PrepareTimeoutBench(data, delays, count);
+
+	HANDLE hNeverSignaled = CreateEvent(NULL, TRUE, FALSE, NULL);
+	std::vector<PollingWaitParams> params(count);
+	std::vector<HANDLE> threads;
+	threads.reserve(count);
+
+	ULONGLONG cpuBefore = GetProcessCpuTime100ns();
+	for (size_t i = 0; i < count; ++i) {
+		LARGE_INTEGER now;
+		QueryPerformanceCounter(&now);
+		data.deadlines[i] = now.QuadPart + (LONGLONG)delays[i] * frequency / 1000;
+		params[i] = { &data, i, delays[i], hNeverSignaled };
+
+		HANDLE hThread = reinterpret_cast<HANDLE>(_beginthreadex(
+			NULL, 64 * 1024, PollingWaitThread, &params[i], STACK_SIZE_PARAM_IS_A_RESERVATION, NULL));
+		if (hThread == NULL) {
+			std::cout << i << "번째 스레드 생성 실패, 측정 중단" << std::endl;
+			for (size_t j = i; j < count; ++j) {   // 만들지 못한 대기는 완료로 처리
+				data.fired[j] = data.deadlines[j] = 0;
+				if (InterlockedDecrement(&data.remaining) == 0) SetEvent(data.hDone);
 			}
 			break;
+		}
+		threads.push_back(hThread);
+	}
+	WaitForSingleObject(data.hDone, INFINITE);
+	ULONGLONG cpuUsed = GetProcessCpuTime100ns() - cpuBefore;
+
+	for (HANDLE h : threads) {
+		WaitForSingleObject(h, INFINITE);
+		CloseHandle(h);
+	}
+	CloseHandle(hNeverSignaled);
+	CloseHandle(data.hDone);
+	PrintTimeoutBenchResult("대기당 스레드", data, cpuUsed, frequency);
+}
+
+// ============================================================================
+// 결과 전달 비용 벤치마크: 스레드 종료 코드 vs 스레드 풀 + Future
+// ============================================================================
+unsigned __stdcall ReturnDoubleWorker(void* param)
+{
+	return (unsigned)(UINT_PTR)param * 2;
+}
+
+void BenchmarkFutures()
+{
+	const int taskCount = 20000;
+	LARGE_INTEGER freq, start, end;
+	QueryPerformanceFrequency(&freq);
+	auto elapsedUs = [&freq, &start, &end]() { return (double)(end.QuadPart - start.QuadPart) * 1e6 / freq.QuadPart; };
 
-		case WAIT_FAILED:
-			std::cout << "\n상태 확인 실패!" << std::endl;
-			CloseHandle(hThread);
-			return;
+	std::cout << "=== 결과 전달 비용 벤치마크 (작업 " << taskCount << "개) ===" << std::endl;
+
+	// 1) _beginthreadex + WaitForMultipleObjects + GetExitCodeThread (64개씩)
+	unsigned long long threadSum = 0;
+	QueryPerformanceCounter(&start);
+	for (int base = 0; base < taskCount; base += MAXIMUM_WAIT_OBJECTS) {
+		HANDLE threads[MAXIMUM_WAIT_OBJECTS];
+		DWORD count = 0;
+		for (int i = base; i < taskCount && count < MAXIMUM_WAIT_OBJECTS; ++i) {
+			threads[count] = reinterpret_cast<HANDLE>(_beginthreadex(NULL, 0, ReturnDoubleWorker, (void*)(UINT_PTR)i, 0, NULL));
+			if (threads[count] != NULL) ++count;
+		}
+		WaitForMultipleObjects(count, threads, TRUE, INFINITE);
+		for (DWORD i = 0; i < count; ++i) {
+			DWORD exitCode = 0;
+			GetExitCodeThread(threads[i], &exitCode);
+			threadSum += exitCode;
+			CloseHandle(threads[i]);
 		}
 	}
+	QueryPerformanceCounter(&end);
+	double threadUs = elapsedUs();
+
+	// 2) RunAsync + WhenAll
+	unsigned long long futureSum = 0;
+	QueryPerformanceCounter(&start);
+	{
+		std::vector<Future<unsigned>> futures;
+		futures.reserve(taskCount);
+		for (int i = 0; i < taskCount; ++i) {
+			futures.push_back(RunAsync([i]() { return (unsigned)i * 2; }));
+		}
+		Future<std::vector<unsigned>> all = WhenAll(futures);
+		for (unsigned v : all.Get()) futureSum += v;
+	}
+	QueryPerformanceCounter(&end);
+	double futureUs = elapsedUs();
+
+	// 3) 같은 스레드에서 Promise 완료 + Get (상태 워드 자체의 비용)
+	QueryPerformanceCounter(&start);
+	unsigned long long inlineSum = 0;
+	for (int i = 0; i < taskCount; ++i) {
+		Promise<unsigned> promise;
+		Future<unsigned> future = promise.GetFuture();
+		promise.SetValue((unsigned)i * 2);
+		inlineSum += future.Get();
+	}
+	QueryPerformanceCounter(&end);
+	double inlineUs = elapsedUs();
+
+	char line[256];
+	StringCchPrintfA(line, 256, "스레드 + 종료 코드   : 작업당 %8.2f us (합계 %llu)", threadUs / taskCount, threadSum);
+	std::cout << line << std::endl;
+	StringCchPrintfA(line, 256, "스레드 풀 + Future   : 작업당 %8.2f us (합계 %llu)", futureUs / taskCount, futureSum);
+	std::cout << line << std::endl;
+	StringCchPrintfA(line, 256, "Promise 완료 + Get   : 작업당 %8.3f us (합계 %llu)", inlineUs / taskCount, inlineSum);
+	std::cout << line << std::endl;
 }
 
-int main()
+// ============================================================================
+// 헤지 요청 꼬리 지연 벤치마크
+// ============================================================================
+// 대부분 5~15ms에 끝나지만 10%는 100~300ms 걸리는 UnpredictableWorker 형태의 작업
+unsigned HeavyTailWork(const StopToken& token, std::mt19937& gen)
 {
+	std::uniform_int_distribution<> slow(1, 10);
+	std::uniform_int_distribution<> fastMs(5, 15);
+	std::uniform_int_distribution<> slowMs(100, 300);
+	DWORD ms = slow(gen) == 1 ? slowMs(gen) : fastMs(gen);
+	return token.SleepFor(ms) ? ms : 0;
+}
+
+void RunHedgeBench(const char* label, int requestCount, int attempts, DWORD hedgeDelayMs)
+{
+	std::vector<double> latencies;
+	double wastedMs = 0;
+	int skipped = 0;
+	LARGE_INTEGER freq;
+	QueryPerformanceFrequency(&freq);
+
+	for (int r = 0; r < requestCount; ++r) {
+		std::vector<std::function<unsigned(const StopToken&)>> tasks;
+		for (int a = 0; a < attempts; ++a) {
+			unsigned seed = (unsigned)(r * 16 + a);
+			tasks.push_back([seed](const StopToken& token) {
+				std::mt19937 gen(seed);
+				return HeavyTailWork(token, gen);
+			});
+		}
+
+		LARGE_INTEGER start, end;
+		QueryPerformanceCounter(&start);
+		RaceHandle<unsigned> race = Race(tasks, hedgeDelayMs);
+		race.first.Get();
+		QueryPerformanceCounter(&end);
+		latencies.push_back((double)(end.QuadPart - start.QuadPart) * 1000.0 / freq.QuadPart);
+
+		const RaceReport& report = race.report.Get();
+		wastedMs += report.wastedMs;
+		skipped += report.losersSkipped;
+	}
+
+	std::sort(latencies.begin(), latencies.end());
+	double sum = 0;
+	for (double v : latencies) sum += v;
+
+	char line[256];
+	StringCchPrintfA(line, 256, "%-20s 평균 %7.2f ms | p50 %7.2f ms | p99 %7.2f ms | 요청당 낭비 %6.2f ms | 시작 안 함 %4d회",
+		label, sum / latencies.size(), latencies[latencies.size() / 2], latencies[latencies.size() * 99 / 100],
+		wastedMs / requestCount, skipped);
+	std::cout << line << std::endl;
+}
+
+void BenchmarkHedging()
+{
+	const int requestCount = 300;
+	std::cout << "=== 헤지 요청 꼬리 지연 벤치마크 (요청 " << requestCount << "개, 10%가 100~300ms) ===" << std::endl;
+	RunHedgeBench("단일 시도", requestCount, 1, 0);
+	RunHedgeBench("2회 동시 실행", requestCount, 2, 0);
+	RunHedgeBench("2회, 20ms 후 헤지", requestCount, 2, 20);
+}
+
+void BenchmarkTimeouts()
+{
+	const size_t wheelCount = 100000;
+	const size_t threadCount = 2000;   // 스레드 10만 개는 만들 수 없으므로 규모를 줄여 대기당 비용으로 비교
+
+	LARGE_INTEGER freq;
+	QueryPerformanceFrequency(&freq);
+
+	std::cout << "=== 동시 타임아웃 벤치마크 (100~2000ms 무작위) ===" << std::endl;
+	RunWheelTimeoutBench(wheelCount, freq.QuadPart);
+	RunThreadPerWaitBench(threadCount, freq.QuadPart);
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc > 1 && strcmp(argv[1], "--bench-timers") == 0) {
+		BenchmarkTimeouts();
+		return 0;
+	}
+	if (argc > 1 && strcmp(argv[1], "--bench-futures") == 0) {
+		BenchmarkFutures();
+		return 0;
+	}
+	if (argc > 1 && strcmp(argv[1], "--bench-race") == 0) {
+		BenchmarkHedging();
+		return 0;
+	}
+
 	std::cout << "Windows 스레드 대기 함수 데모 (_beginthreadex 사용)\n" << std::endl;
 
+	// 상태 확인/진행 표시 콜백을 처리하는 공용 타이머 서비스
+	TimerWheel wheel;
+	wheel.Start();
+
 	// 각 데모 함수 실행
-	DemonstrateSingleObjectWait();
+	DemonstrateSingleObjectWait(wheel);
 	DemonstrateMultipleObjectsWait();
+	DemonstrateRace();
 	DemonstrateTimeoutWait();
-	DemonstratePeriodicStatusCheck();
+	DemonstratePeriodicStatusCheck(wheel);
+
+	wheel.Stop();
 
 	std::cout << "\n모든 데모 완료!" << std::endl;
 	return 0;
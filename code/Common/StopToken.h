@@ -0,0 +1,87 @@
+﻿#pragma once
+
+#include <windows.h>
+#include <memory>
+#include <utility>
+
+// WaitOnAddress / WakeByAddressAll (Windows 8 이상)
+#pragma comment(lib, "Synchronization.lib")
+
+// ============================================================================
+// 협력적 취소 토큰 (std::stop_token과 비슷한 구조)
+// ============================================================================
+// 04__beginthread의 워커 중지와 05_WaitForSingleObject의 경주 실행(Race)이 함께 씁니다.
+// 일반 bool 플래그는 동기화가 없어서 컴파일러가 루프 밖으로 읽기를 빼낼 수 있고,
+// Sleep(500) 중인 워커는 중지 요청을 최대 500ms 늦게 확인합니다.
+// StopSource가 요청을 보내면 WaitOnAddress로 잠든 StopToken::SleepFor가 바로 깨어납니다.
+
+// StopSource와 StopToken이 공유하는 상태
+struct StopState
+{
+	volatile LONG stopRequested;
+
+	StopState() : stopRequested(0) {}
+};
+
+class StopToken
+{
+private:
+	std::shared_ptr<StopState> m_state;
+
+public:
+	StopToken() {}
+	explicit StopToken(std::shared_ptr<StopState> state) : m_state(std::move(state)) {}
+
+	// 연결된 StopSource가 없으면 중지될 일도 없음
+	bool StopPossible() const { return m_state != nullptr; }
+
+	bool StopRequested() const
+	{
+		return m_state && InterlockedCompareExchange(&m_state->stopRequested, 0, 0) != 0;
+	}
+
+	// milliseconds 동안 잠들되, 중지 요청이 오면 즉시 깨어난다
+	// 시간이 다 되어 깨어나면 true, 중지 요청으로 깨어나면 false
+	bool SleepFor(DWORD milliseconds) const
+	{
+		if (!m_state) {
+			Sleep(milliseconds);
+			return true;
+		}
+
+		ULONGLONG deadline = GetTickCount64() + milliseconds;
+		LONG notStopped = 0;
+		while (!StopRequested()) {
+			DWORD timeout = INFINITE;
+			if (milliseconds != INFINITE) {
+				ULONGLONG now = GetTickCount64();
+				if (now >= deadline) return true;
+				timeout = (DWORD)(deadline - now);
+			}
+			// 값이 아직 0이면 잠든다. 가짜 깨어남이 있을 수 있으므로 루프에서 다시 확인
+			WaitOnAddress(&m_state->stopRequested, &notStopped, sizeof(LONG), timeout);
+		}
+		return false;
+	}
+};
+
+class StopSource
+{
+private:
+	std::shared_ptr<StopState> m_state;
+
+public:
+	StopSource() : m_state(std::make_shared<StopState>()) {}
+
+	StopToken GetToken() const { return StopToken(m_state); }
+
+	bool StopRequested() const { return GetToken().StopRequested(); }
+
+	// 처음 요청한 호출만 true를 반환하고, 잠들어 있는 모든 대기자를 깨운다
+	bool RequestStop() const
+	{
+		if (InterlockedExchange(&m_state->stopRequested, 1) != 0) return false;
+		WakeByAddressAll((PVOID)&m_state->stopRequested);
+		return true;
+	}
+};
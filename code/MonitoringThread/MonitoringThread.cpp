@@ -2,28 +2,580 @@
 #include <thread>
 #include <vector>
 #include <chrono>
+#include <string>
+#include <cstdint>
+#include <cstring>
 #include <windows.h>
+#include <intrin.h>
+#include <immintrin.h>
 
-void cpuIntensiveTask(int threadId, int seconds)
+// ============================================================================
+// CPU 부하 커널
+// ============================================================================
+// 작업 관리자에서 CPU 사용률만 보는 것이 아니라, 실제 연산(내적, SAXPY, 누적합,
+// 히스토그램)을 돌려서 스레드당/전체 GFLOP/s, GB/s를 측정합니다.
+// 각 커널은 스칼라 버전과 SSE / AVX2 / AVX-512 버전이 있고,
+// 실행 시점에 CPUID로 지원 여부를 확인해서 선택합니다.
+
+enum class KernelType { DotProduct, Saxpy, PrefixSum, Histogram };
+enum class SimdLevel { Scalar, SSE, AVX2, AVX512 };
+
+struct KernelInfo {
+    const char* name;
+    double flopsPerElement;  // 원소 하나당 부동소수점 연산 수 (0이면 GB/s만 의미 있음)
+    double bytesPerElement;  // 원소 하나당 읽고 쓰는 바이트 수
+};
+
+const KernelInfo& GetKernelInfo(KernelType type)
+{
+    static const KernelInfo infos[] = {
+        { "dot",    2.0, 8.0  },   // a[i]*b[i] 누적: 곱셈+덧셈, 읽기 2개
+        { "saxpy",  2.0, 12.0 },   // y = a*x + y: 곱셈+덧셈, 읽기 2개 + 쓰기 1개
+        { "prefix", 1.0, 8.0  },   // out[i] = out[i-1] + in[i]: 덧셈, 읽기 1개 + 쓰기 1개
+        { "hist",   0.0, 4.0  },   // 값 -> 구간 인덱스 -> 카운트 증가
+    };
+    return infos[static_cast<int>(type)];
+}
+
+const char* GetSimdName(SimdLevel level)
+{
+    switch (level) {
+    case SimdLevel::SSE:    return "SSE";
+    case SimdLevel::AVX2:   return "AVX2";
+    case SimdLevel::AVX512: return "AVX-512";
+    default:                return "Scalar";
+    }
+}
+
+// CPUID + XGETBV로 CPU와 OS가 모두 지원하는 가장 높은 SIMD 단계를 확인
+SimdLevel DetectSimdLevel()
+{
+    int info[4] = { 0 };
+    __cpuid(info, 0);
+    int maxLeaf = info[0];
+
+    __cpuid(info, 1);
+    bool sse2 = (info[3] & (1 << 26)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+
+    // OS가 YMM/ZMM 레지스터를 컨텍스트 스위치 때 저장해 주는지 확인
+    unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+    bool osYmm = (xcr0 & 0x6) == 0x6;
+    bool osZmm = (xcr0 & 0xE6) == 0xE6;
+
+    bool avx2 = false;
+    bool avx512f = false;
+    if (maxLeaf >= 7) {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+        avx512f = (info[1] & (1 << 16)) != 0;
+    }
+
+    if (avx512f && osZmm) return SimdLevel::AVX512;
+    if (avx2 && avx && osYmm) return SimdLevel::AVX2;
+    if (sse2) return SimdLevel::SSE;
+    return SimdLevel::Scalar;
+}
+
+// ---------------------------------------------------------------------------
+// 수평 합 도우미
+// ---------------------------------------------------------------------------
+inline float HorizontalSum(__m128 v)
+{
+    __m128 shuf = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+    __m128 sums = _mm_add_ps(v, shuf);
+    shuf = _mm_movehl_ps(shuf, sums);
+    sums = _mm_add_ss(sums, shuf);
+    return _mm_cvtss_f32(sums);
+}
+
+inline float HorizontalSum(__m256 v)
+{
+    return HorizontalSum(_mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1)));
+}
+
+// ---------------------------------------------------------------------------
+// 내적 (dot product)
+// ---------------------------------------------------------------------------
+float DotScalar(const float* a, const float* b, size_t n)
+{
+    float sum = 0.0f;
+#pragma loop(no_vector)
+    for (size_t i = 0; i < n; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+float DotSSE(const float* a, const float* b, size_t n)
+{
+    __m128 acc = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    }
+    float sum = HorizontalSum(acc);
+    for (; i < n; ++i) sum += a[i] * b[i];
+    return sum;
+}
+
+float DotAVX2(const float* a, const float* b, size_t n)
+{
+    __m256 acc = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+    }
+    float sum = HorizontalSum(acc);
+    for (; i < n; ++i) sum += a[i] * b[i];
+    return sum;
+}
+
+float DotAVX512(const float* a, const float* b, size_t n)
+{
+    __m512 acc = _mm512_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        acc = _mm512_add_ps(acc, _mm512_mul_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i)));
+    }
+    float sum = _mm512_reduce_add_ps(acc);
+    for (; i < n; ++i) sum += a[i] * b[i];
+    return sum;
+}
+
+// ---------------------------------------------------------------------------
+// SAXPY: y = alpha * x + y
+// ---------------------------------------------------------------------------
+void SaxpyScalar(float alpha, const float* x, float* y, size_t n)
+{
+#pragma loop(no_vector)
+    for (size_t i = 0; i < n; ++i) {
+        y[i] = alpha * x[i] + y[i];
+    }
+}
+
+void SaxpySSE(float alpha, const float* x, float* y, size_t n)
+{
+    __m128 va = _mm_set1_ps(alpha);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_ps(y + i, _mm_add_ps(_mm_mul_ps(va, _mm_loadu_ps(x + i)), _mm_loadu_ps(y + i)));
+    }
+    for (; i < n; ++i) y[i] = alpha * x[i] + y[i];
+}
+
+void SaxpyAVX2(float alpha, const float* x, float* y, size_t n)
+{
+    __m256 va = _mm256_set1_ps(alpha);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(y + i, _mm256_add_ps(_mm256_mul_ps(va, _mm256_loadu_ps(x + i)), _mm256_loadu_ps(y + i)));
+    }
+    for (; i < n; ++i) y[i] = alpha * x[i] + y[i];
+}
+
+void SaxpyAVX512(float alpha, const float* x, float* y, size_t n)
 {
-    auto start = std::chrono::high_resolution_clock::now();
-    auto end = start + std::chrono::seconds(seconds);
+    __m512 va = _mm512_set1_ps(alpha);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        _mm512_storeu_ps(y + i, _mm512_add_ps(_mm512_mul_ps(va, _mm512_loadu_ps(x + i)), _mm512_loadu_ps(y + i)));
+    }
+    for (; i < n; ++i) y[i] = alpha * x[i] + y[i];
+}
+
+// ---------------------------------------------------------------------------
+// 누적합 (inclusive prefix sum)
+// 레지스터 안에서 shift + add를 log2(폭)번 반복하고, 이전 블록의 마지막 값을 더합니다.
+// ---------------------------------------------------------------------------
+void PrefixSumScalar(const float* in, float* out, size_t n)
+{
+    float running = 0.0f;
+#pragma loop(no_vector)
+    for (size_t i = 0; i < n; ++i) {
+        running += in[i];
+        out[i] = running;
+    }
+}
+
+void PrefixSumSSE(const float* in, float* out, size_t n)
+{
+    __m128 carry = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 x = _mm_loadu_ps(in + i);
+        x = _mm_add_ps(x, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 4)));
+        x = _mm_add_ps(x, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 8)));
+        x = _mm_add_ps(x, carry);
+        _mm_storeu_ps(out + i, x);
+        carry = _mm_shuffle_ps(x, x, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+    float running = _mm_cvtss_f32(carry);
+    for (; i < n; ++i) {
+        running += in[i];
+        out[i] = running;
+    }
+}
+
+void PrefixSumAVX2(const float* in, float* out, size_t n)
+{
+    __m256 carry = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 x = _mm256_loadu_ps(in + i);
+        // 128비트 레인 안에서 누적
+        x = _mm256_add_ps(x, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(x), 4)));
+        x = _mm256_add_ps(x, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(x), 8)));
+        // 아래 레인의 마지막 값을 위 레인 전체에 더함
+        __m256 lowTail = _mm256_permute_ps(x, _MM_SHUFFLE(3, 3, 3, 3));
+        x = _mm256_add_ps(x, _mm256_permute2f128_ps(lowTail, lowTail, 0x08));
+        x = _mm256_add_ps(x, carry);
+        _mm256_storeu_ps(out + i, x);
+        __m256 tail = _mm256_permute_ps(x, _MM_SHUFFLE(3, 3, 3, 3));
+        carry = _mm256_permute2f128_ps(tail, tail, 0x11);
+    }
+    float running = _mm256_cvtss_f32(carry);
+    for (; i < n; ++i) {
+        running += in[i];
+        out[i] = running;
+    }
+}
+
+void PrefixSumAVX512(const float* in, float* out, size_t n)
+{
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i lastIndex = _mm512_set1_epi32(15);
+    __m512 carry = _mm512_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512i x = _mm512_castps_si512(_mm512_loadu_ps(in + i));
+        // alignr로 원소를 1, 2, 4, 8칸씩 밀어서 더함 (빈 칸은 0)
+        x = _mm512_castps_si512(_mm512_add_ps(_mm512_castsi512_ps(x), _mm512_castsi512_ps(_mm512_alignr_epi32(x, zero, 15))));
+        x = _mm512_castps_si512(_mm512_add_ps(_mm512_castsi512_ps(x), _mm512_castsi512_ps(_mm512_alignr_epi32(x, zero, 14))));
+        x = _mm512_castps_si512(_mm512_add_ps(_mm512_castsi512_ps(x), _mm512_castsi512_ps(_mm512_alignr_epi32(x, zero, 12))));
+        x = _mm512_castps_si512(_mm512_add_ps(_mm512_castsi512_ps(x), _mm512_castsi512_ps(_mm512_alignr_epi32(x, zero, 8))));
+        __m512 result = _mm512_add_ps(_mm512_castsi512_ps(x), carry);
+        _mm512_storeu_ps(out + i, result);
+        carry = _mm512_permutexvar_ps(lastIndex, result);
+    }
+    float running = _mm512_cvtss_f32(carry);
+    for (; i < n; ++i) {
+        running += in[i];
+        out[i] = running;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// 히스토그램: [0, 1) 범위 값을 256개 구간으로 집계
+// 카운트 증가(scatter)는 SIMD로 충돌 없이 처리하기 어려우므로, SIMD 버전은
+// 구간 인덱스 계산을 벡터화하고 4개의 부분 히스토그램에 나눠 더해서
+// 같은 구간에 대한 store->load 의존성을 줄입니다.
+// ---------------------------------------------------------------------------
+const int kHistogramBins = 256;
+
+void HistogramScalar(const float* data, size_t n, uint32_t* bins)
+{
+#pragma loop(no_vector)
+    for (size_t i = 0; i < n; ++i) {
+        bins[static_cast<int>(data[i] * kHistogramBins)]++;
+    }
+}
+
+template <int Width>
+inline void AccumulateBins(const int32_t* index, uint32_t (*partial)[kHistogramBins])
+{
+    for (int k = 0; k < Width; ++k) {
+        partial[k & 3][index[k]]++;
+    }
+}
 
-    while (std::chrono::high_resolution_clock::now() < end) {
-        // CPU 집약적 작업 시뮬레이션
-        volatile int dummy = 0;
-        for (int i = 0; i < 1000000; ++i) {
-            dummy += i;
+inline void MergeBins(uint32_t (*partial)[kHistogramBins], uint32_t* bins)
+{
+    for (int b = 0; b < kHistogramBins; ++b) {
+        bins[b] += partial[0][b] + partial[1][b] + partial[2][b] + partial[3][b];
+    }
+}
+
+void HistogramSSE(const float* data, size_t n, uint32_t* bins)
+{
+    uint32_t partial[4][kHistogramBins] = {};
+    alignas(16) int32_t index[4];
+    __m128 scale = _mm_set1_ps(static_cast<float>(kHistogramBins));
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm_store_si128(reinterpret_cast<__m128i*>(index), _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(data + i), scale)));
+        AccumulateBins<4>(index, partial);
+    }
+    for (; i < n; ++i) partial[0][static_cast<int>(data[i] * kHistogramBins)]++;
+    MergeBins(partial, bins);
+}
+
+void HistogramAVX2(const float* data, size_t n, uint32_t* bins)
+{
+    uint32_t partial[4][kHistogramBins] = {};
+    alignas(32) int32_t index[8];
+    __m256 scale = _mm256_set1_ps(static_cast<float>(kHistogramBins));
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(index), _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_loadu_ps(data + i), scale)));
+        AccumulateBins<8>(index, partial);
+    }
+    for (; i < n; ++i) partial[0][static_cast<int>(data[i] * kHistogramBins)]++;
+    MergeBins(partial, bins);
+}
+
+void HistogramAVX512(const float* data, size_t n, uint32_t* bins)
+{
+    uint32_t partial[4][kHistogramBins] = {};
+    alignas(64) int32_t index[16];
+    __m512 scale = _mm512_set1_ps(static_cast<float>(kHistogramBins));
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        _mm512_store_si512(index, _mm512_cvttps_epi32(_mm512_mul_ps(_mm512_loadu_ps(data + i), scale)));
+        AccumulateBins<16>(index, partial);
+    }
+    for (; i < n; ++i) partial[0][static_cast<int>(data[i] * kHistogramBins)]++;
+    MergeBins(partial, bins);
+}
+
+// ---------------------------------------------------------------------------
+// 커널 실행기
+// ---------------------------------------------------------------------------
+struct KernelConfig {
+    KernelType type;
+    SimdLevel level;
+};
+
+struct KernelStats {
+    unsigned long long elements = 0;  // 처리한 원소 수
+    double seconds = 0.0;             // 실제 측정 시간
+
+    double GFlops(KernelType type) const {
+        return seconds > 0 ? elements * GetKernelInfo(type).flopsPerElement / seconds / 1e9 : 0.0;
+    }
+    double GBytes(KernelType type) const {
+        return seconds > 0 ? elements * GetKernelInfo(type).bytesPerElement / seconds / 1e9 : 0.0;
+    }
+};
+
+// 결과를 버리지 않도록 모아두는 곳 (컴파일러가 커널을 제거하지 못하게)
+volatile float g_kernelSink = 0.0f;
+
+class KernelRunner
+{
+private:
+    // 스레드당 작업 크기: 64K 원소(배열당 256KB)로 L2 캐시 근처에 머무르게 함
+    static const size_t kElements = 64 * 1024;
+    // 시간 확인 간격: 이 횟수만큼 커널을 돈 뒤에만 시계를 확인
+    static const int kPassesPerCheck = 16;
+
+    KernelConfig m_config;
+    std::vector<float> m_a;
+    std::vector<float> m_b;
+    std::vector<uint32_t> m_bins;
+
+public:
+    explicit KernelRunner(KernelConfig config)
+        : m_config(config), m_a(kElements), m_b(kElements), m_bins(kHistogramBins, 0)
+    {
+        // [0, 1) 범위의 값으로 채움 (히스토그램 인덱스가 범위를 넘지 않도록)
+        uint32_t seed = 12345;
+        for (size_t i = 0; i < kElements; ++i) {
+            seed = seed * 1664525u + 1013904223u;
+            m_a[i] = (seed >> 8) * (1.0f / 16777216.0f);
+            m_b[i] = 1.0f - m_a[i];
+        }
+    }
+
+    void RunPass()
+    {
+        const float* a = m_a.data();
+        float* b = m_b.data();
+        const size_t n = kElements;
+
+        switch (m_config.type) {
+        case KernelType::DotProduct: {
+            float sum = 0.0f;
+            switch (m_config.level) {
+            case SimdLevel::SSE:    sum = DotSSE(a, b, n); break;
+            case SimdLevel::AVX2:   sum = DotAVX2(a, b, n); break;
+            case SimdLevel::AVX512: sum = DotAVX512(a, b, n); break;
+            default:                sum = DotScalar(a, b, n); break;
+            }
+            g_kernelSink = sum;
+            break;
+        }
+        case KernelType::Saxpy:
+            // 값이 계속 커지지 않도록 작은 alpha 사용
+            switch (m_config.level) {
+            case SimdLevel::SSE:    SaxpySSE(1e-6f, a, b, n); break;
+            case SimdLevel::AVX2:   SaxpyAVX2(1e-6f, a, b, n); break;
+            case SimdLevel::AVX512: SaxpyAVX512(1e-6f, a, b, n); break;
+            default:                SaxpyScalar(1e-6f, a, b, n); break;
+            }
+            g_kernelSink = b[n - 1];
+            break;
+        case KernelType::PrefixSum:
+            switch (m_config.level) {
+            case SimdLevel::SSE:    PrefixSumSSE(a, b, n); break;
+            case SimdLevel::AVX2:   PrefixSumAVX2(a, b, n); break;
+            case SimdLevel::AVX512: PrefixSumAVX512(a, b, n); break;
+            default:                PrefixSumScalar(a, b, n); break;
+            }
+            g_kernelSink = b[n - 1];
+            break;
+        case KernelType::Histogram:
+            switch (m_config.level) {
+            case SimdLevel::SSE:    HistogramSSE(a, n, m_bins.data()); break;
+            case SimdLevel::AVX2:   HistogramAVX2(a, n, m_bins.data()); break;
+            case SimdLevel::AVX512: HistogramAVX512(a, n, m_bins.data()); break;
+            default:                HistogramScalar(a, n, m_bins.data()); break;
+            }
+            g_kernelSink = static_cast<float>(m_bins[0]);
+            break;
+        }
+    }
+
+    KernelStats RunFor(std::chrono::milliseconds duration)
+    {
+        KernelStats stats;
+        auto start = std::chrono::high_resolution_clock::now();
+        auto end = start + duration;
+        auto now = start;
+
+        while (now < end) {
+            for (int pass = 0; pass < kPassesPerCheck; ++pass) {
+                RunPass();
+            }
+            stats.elements += static_cast<unsigned long long>(kElements) * kPassesPerCheck;
+            now = std::chrono::high_resolution_clock::now();
         }
+
+        stats.seconds = std::chrono::duration<double>(now - start).count();
+        return stats;
+    }
+};
+
+void PrintStats(const char* label, KernelType type, const KernelStats& stats)
+{
+    std::cout << label << ": ";
+    if (GetKernelInfo(type).flopsPerElement > 0) {
+        std::cout << stats.GFlops(type) << " GFLOP/s, ";
     }
+    std::cout << stats.GBytes(type) << " GB/s" << std::endl;
+}
+
+void cpuIntensiveTask(int threadId, int seconds, KernelConfig config, KernelStats* result)
+{
+    KernelRunner runner(config);
+    KernelStats stats = runner.RunFor(std::chrono::seconds(seconds));
+    if (result) *result = stats;
 
-    std::cout << "스레드 " << threadId << " 완료" << std::endl;
+    std::cout << "스레드 " << threadId << " 완료 ("
+        << GetKernelInfo(config.type).name << ", " << GetSimdName(config.level) << ")" << std::endl;
 }
 
-int main()
+// N개 스레드로 같은 커널을 돌리고 스레드별/전체 처리량 반환
+KernelStats RunKernelOnThreads(int threadCount, int seconds, KernelConfig config, bool printPerThread)
 {
+    std::vector<KernelStats> perThread(threadCount);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadCount; ++i) {
+        threads.emplace_back(cpuIntensiveTask, i, seconds, config, &perThread[i]);
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    // 전체 처리량 = 모든 스레드 처리량의 합 (가장 오래 걸린 스레드 시간 기준)
+    KernelStats total;
+    for (int i = 0; i < threadCount; ++i) {
+        if (printPerThread) {
+            PrintStats(("  스레드 " + std::to_string(i)).c_str(), config.type, perThread[i]);
+        }
+        total.elements += perThread[i].elements;
+        if (perThread[i].seconds > total.seconds) total.seconds = perThread[i].seconds;
+    }
+    return total;
+}
+
+// 커널 x SIMD 단계 비교표: 단일 스레드와 전체 코어에서의 처리량
+void CompareScalarAndSimd(SimdLevel maxLevel, int threadCount)
+{
+    std::cout << "\n=== 스칼라 vs SIMD 비교 (커널당 1초, 1 스레드 / "
+        << threadCount << " 스레드) ===" << std::endl;
+
+    const KernelType kernels[] = { KernelType::DotProduct, KernelType::Saxpy, KernelType::PrefixSum, KernelType::Histogram };
+    const SimdLevel levels[] = { SimdLevel::Scalar, SimdLevel::SSE, SimdLevel::AVX2, SimdLevel::AVX512 };
+
+    for (KernelType kernel : kernels) {
+        for (SimdLevel level : levels) {
+            if (level > maxLevel) break;
+
+            KernelConfig config = { kernel, level };
+            KernelStats single = RunKernelOnThreads(1, 1, config, false);
+            KernelStats multi = RunKernelOnThreads(threadCount, 1, config, false);
+
+            std::string label = std::string(GetKernelInfo(kernel).name) + " / " + GetSimdName(level);
+            PrintStats((label + " (1)").c_str(), kernel, single);
+            PrintStats((label + " (" + std::to_string(threadCount) + ")").c_str(), kernel, multi);
+            if (single.elements > 0) {
+                std::cout << "  -> 확장성: "
+                    << (static_cast<double>(multi.elements) / multi.seconds) / (static_cast<double>(single.elements) / single.seconds)
+                    << "배" << std::endl;
+            }
+        }
+    }
+}
+
+bool ParseKernel(const char* arg, KernelType& type)
+{
+    const KernelType kernels[] = { KernelType::DotProduct, KernelType::Saxpy, KernelType::PrefixSum, KernelType::Histogram };
+    for (KernelType kernel : kernels) {
+        if (std::strcmp(arg, GetKernelInfo(kernel).name) == 0) {
+            type = kernel;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ParseSimdLevel(const char* arg, SimdLevel& level)
+{
+    if (std::strcmp(arg, "scalar") == 0) level = SimdLevel::Scalar;
+    else if (std::strcmp(arg, "sse") == 0) level = SimdLevel::SSE;
+    else if (std::strcmp(arg, "avx2") == 0) level = SimdLevel::AVX2;
+    else if (std::strcmp(arg, "avx512") == 0) level = SimdLevel::AVX512;
+    else return false;
+    return true;
+}
+
+// 사용법: MonitoringThread.exe [dot|saxpy|prefix|hist] [scalar|sse|avx2|avx512]
+int main(int argc, char* argv[])
+{
+    SimdLevel detected = DetectSimdLevel();
+    KernelConfig config = { KernelType::DotProduct, detected };
+
+    if (argc > 1 && !ParseKernel(argv[1], config.type)) {
+        std::cout << "알 수 없는 커널: " << argv[1] << " (dot, saxpy, prefix, hist 중 선택)" << std::endl;
+        return 1;
+    }
+    if (argc > 2) {
+        if (!ParseSimdLevel(argv[2], config.level)) {
+            std::cout << "알 수 없는 SIMD 단계: " << argv[2] << " (scalar, sse, avx2, avx512 중 선택)" << std::endl;
+            return 1;
+        }
+        if (config.level > detected) {
+            std::cout << GetSimdName(config.level) << "을(를) 지원하지 않아 " << GetSimdName(detected) << "(으)로 실행합니다." << std::endl;
+            config.level = detected;
+        }
+    }
+
     std::cout << "현재 프로세스 ID: " << GetCurrentProcessId() << std::endl;
     std::cout << "Task Manager에서 이 PID를 찾아보세요!" << std::endl;
+    std::cout << "지원 SIMD: " << GetSimdName(detected)
+        << ", 실행 커널: " << GetKernelInfo(config.type).name << " (" << GetSimdName(config.level) << ")" << std::endl;
 
     std::cout << std::endl;
     std::cout << "10초 후 스레드 생성합니다" << std::endl;
@@ -31,21 +583,22 @@ int main()
 
     std::cout << "\n1단계: 단일 스레드로 실행 (10초)" << std::endl;
     std::this_thread::sleep_for(std::chrono::seconds(2));
-    cpuIntensiveTask(0, 8);
+    KernelStats single = RunKernelOnThreads(1, 8, config, true);
 
     std::cout << "\n2단계: 8개 스레드로 실행 (10초)" << std::endl;
     std::this_thread::sleep_for(std::chrono::seconds(2));
-
-    std::vector<std::thread> threads;
-    for (int i = 0; i < 8; ++i) {
-        threads.emplace_back(cpuIntensiveTask, i, 8);
+    KernelStats multi = RunKernelOnThreads(8, 8, config, true);
+    PrintStats("  전체 (8 스레드)", config.type, multi);
+    if (single.elements > 0) {
+        std::cout << "  1 스레드 대비 "
+            << (static_cast<double>(multi.elements) / multi.seconds) / (static_cast<double>(single.elements) / single.seconds)
+            << "배" << std::endl;
     }
 
-    for (auto& t : threads) {
-        t.join();
-    }
+    int hardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+    CompareScalarAndSimd(detected, hardwareThreads > 0 ? hardwareThreads : 8);
 
     std::cout << "관찰 완료. 엔터를 눌러 종료하세요." << std::endl;
     std::cin.get();
     return 0;
-}
\ No newline at end of file
+}